@@ -0,0 +1,362 @@
+/**
+ * Contention stress harness for the lock primitives of bricks.
+ *
+ * Sweeps thread counts, read/write ratios and critical-section lengths for every lock type and
+ * prints one CSV row per (configuration, operation) with acquisition latency percentiles.
+ *
+ * Every thread issues operations on a fixed schedule. Latency is measured from the time an
+ * operation was scheduled to start, not from when the thread got around to it, so stalls behind a
+ * slow acquisition are charged to the operations they delayed (coordinated-omission correction).
+ * The uncorrected p99.9 is reported alongside for comparison.
+ *
+ * Usage: lock_stress [--duration-ms N] [--rate OPS_PER_THREAD_PER_S] [--max-threads N] [--perf 1]
+ *
+ * The duration must be positive, the rate is clamped to [1, 1e9] and the threads to [1, 1024].
+ * Every operation keeps its latencies until the end of its configuration, so combinations of rate,
+ * duration and threads that would record more than 2^23 operations per configuration, about
+ * 256 MiB of samples, are rejected. Unknown flags and flags without a value are rejected too.
+ *
+ * With `--perf 1` every worker thread samples its hardware counters with `bricks::perf_counters`,
+ * and each row gets the IPC and last level cache misses per operation of its configuration. The
+ * columns are zero where the counters are not available.
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bricks/charconv.hpp>
+#include <bricks/mutex.hpp>
+#include <bricks/perf_counters.hpp>
+#include <bricks/rw_lock.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+using nanoseconds = std::chrono::nanoseconds;
+
+constexpr std::uint64_t max_rate = 1'000'000'000;
+constexpr unsigned max_thread_count = 1024;
+// The latencies of every operation of a configuration are kept, 16 bytes per operation in the
+// per-thread samples and again when merging them.
+constexpr double max_samples = 1U << 23U;
+
+constexpr const char* usage =
+    "usage: lock_stress [--duration-ms N] [--rate OPS_PER_THREAD_PER_S] [--max-threads N] "
+    "[--perf 0|1]";
+
+struct options {
+  std::chrono::milliseconds duration{200};
+  std::uint64_t rate{20000};
+  unsigned max_threads{std::max(2U, std::thread::hardware_concurrency())};
+  unsigned perf{0};
+};
+
+auto schedule_period(const options& opts) -> nanoseconds
+{
+  return nanoseconds{std::chrono::seconds{1}} / opts.rate;
+}
+
+auto operations_per_thread(const options& opts) -> std::size_t
+{
+  return static_cast<std::size_t>(opts.duration / schedule_period(opts));
+}
+
+// The expected number of operations of one kind, plus four standard deviations of the binomial
+// distribution, so the vectors almost never grow while measuring.
+auto expected_share(std::size_t operations, double ratio) -> std::size_t
+{
+  const auto n = static_cast<double>(operations);
+  const auto slack = 4.0 * std::sqrt(n * ratio * (1.0 - ratio));
+  return std::min(operations, static_cast<std::size_t>(n * ratio + slack) + 1);
+}
+
+struct config {
+  unsigned threads;
+  double read_ratio;
+  nanoseconds critical_section;
+};
+
+struct shared_state {
+  std::vector<std::uint64_t> data = std::vector<std::uint64_t>(64);
+};
+
+struct samples {
+  std::vector<std::int64_t> corrected;
+  std::vector<std::int64_t> raw;
+};
+
+auto spin_for(nanoseconds duration) -> void
+{
+  const auto end = clock_type::now() + duration;
+  while (clock_type::now() < end) {
+  }
+}
+
+auto percentile(const std::vector<std::int64_t>& sorted, double p) -> std::int64_t
+{
+  if (sorted.empty()) return 0;
+  const auto index = static_cast<std::size_t>(p * static_cast<double>(sorted.size() - 1));
+  return sorted[index];
+}
+
+// The counters are summed over all threads and both operations, since they are per thread.
+auto print_row(const char* lock, const config& cfg, const char* operation, samples& s,
+               std::chrono::duration<double> elapsed, const bricks::perf_sample* perf,
+               std::size_t operations) -> void
+{
+  std::sort(s.corrected.begin(), s.corrected.end());
+  std::sort(s.raw.begin(), s.raw.end());
+  std::printf("%s,%u,%.2f,%lld,%s,%zu,%.0f,%lld,%lld,%lld,%lld,%lld,%lld", lock, cfg.threads,
+              cfg.read_ratio, static_cast<long long>(cfg.critical_section.count()), operation,
+              s.corrected.size(), static_cast<double>(s.corrected.size()) / elapsed.count(),
+              static_cast<long long>(percentile(s.corrected, 0.5)),
+              static_cast<long long>(percentile(s.corrected, 0.9)),
+              static_cast<long long>(percentile(s.corrected, 0.99)),
+              static_cast<long long>(percentile(s.corrected, 0.999)),
+              static_cast<long long>(s.corrected.empty() ? 0 : s.corrected.back()),
+              static_cast<long long>(percentile(s.raw, 0.999)));
+  if (perf != nullptr) {
+    std::printf(",%.3f,%.2f", perf->ipc(),
+                operations == 0 ? 0.0
+                                : static_cast<double>(perf->cache_misses) /
+                                      static_cast<double>(operations));
+  }
+  std::printf("\n");
+}
+
+/**
+ * Lock adapters, giving every lock type the same read/write interface.
+ */
+struct mutex_adapter {
+  static constexpr const char* name = "bricks::mutex";
+  bricks::mutex<shared_state> lock;
+
+  template <typename F>
+  auto read(F&& f) -> void
+  {
+    const auto guard = lock.lock();
+    f(static_cast<const shared_state&>(*guard));
+  }
+
+  template <typename F>
+  auto write(F&& f) -> void
+  {
+    auto guard = lock.lock();
+    f(*guard);
+  }
+};
+
+struct rw_lock_adapter {
+  static constexpr const char* name = "bricks::rw_lock";
+  bricks::rw_lock<shared_state> lock;
+
+  template <typename F>
+  auto read(F&& f) -> void
+  {
+    const auto guard = lock.read();
+    f(*guard);
+  }
+
+  template <typename F>
+  auto write(F&& f) -> void
+  {
+    auto guard = lock.write();
+    f(*guard);
+  }
+};
+
+template <typename Lock>
+auto run(const options& opts, const config& cfg) -> void
+{
+  Lock lock;
+  const auto period = schedule_period(opts);
+  const auto ops_per_thread = operations_per_thread(opts);
+  const auto expected_reads = expected_share(ops_per_thread, cfg.read_ratio);
+  const auto expected_writes = expected_share(ops_per_thread, 1.0 - cfg.read_ratio);
+
+  std::vector<samples> reads(cfg.threads);
+  std::vector<samples> writes(cfg.threads);
+  std::vector<bricks::perf_sample> perf(cfg.threads);
+  for (unsigned t = 0; t < cfg.threads; ++t) {
+    reads[t].corrected.reserve(expected_reads);
+    reads[t].raw.reserve(expected_reads);
+    writes[t].corrected.reserve(expected_writes);
+    writes[t].raw.reserve(expected_writes);
+  }
+
+  std::atomic<bool> go{false};
+  std::vector<std::thread> threads;
+  for (unsigned t = 0; t < cfg.threads; ++t) {
+    threads.emplace_back([&, t] {
+      std::minstd_rand rng{t + 1};
+      std::uniform_real_distribution<double> coin{0.0, 1.0};
+      volatile std::uint64_t observed = 0;
+      // Opened before the start, so the system calls are not part of the measured region.
+      std::optional<bricks::perf_counters> counters;
+      if (opts.perf != 0) counters.emplace();
+      while (!go.load(std::memory_order_acquire)) {
+      }
+
+      std::optional<bricks::perf_counters::scope> region;
+      if (counters) region.emplace(*counters, perf[t]);
+
+      const auto start = clock_type::now();
+      for (std::size_t i = 0; i < ops_per_thread; ++i) {
+        const auto scheduled = start + period * i;
+        while (clock_type::now() < scheduled) {
+          std::this_thread::yield();
+        }
+
+        const auto is_read = coin(rng) < cfg.read_ratio;
+        const auto issued = clock_type::now();
+        clock_type::time_point acquired;
+        const auto critical_section = [&](auto& state) {
+          acquired = clock_type::now();
+          observed = state.data[i % state.data.size()];
+          spin_for(cfg.critical_section);
+        };
+        if (is_read) {
+          lock.read(critical_section);
+        } else {
+          lock.write([&](shared_state& state) {
+            critical_section(state);
+            ++state.data[i % state.data.size()];
+          });
+        }
+
+        auto& s = is_read ? reads[t] : writes[t];
+        s.corrected.push_back((acquired - scheduled).count());
+        s.raw.push_back((acquired - issued).count());
+      }
+    });
+  }
+
+  const auto begin = clock_type::now();
+  go.store(true, std::memory_order_release);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const std::chrono::duration<double> elapsed = clock_type::now() - begin;
+
+  const auto merge = [](std::vector<samples>& per_thread) {
+    samples all;
+    for (auto& s : per_thread) {
+      all.corrected.insert(all.corrected.end(), s.corrected.begin(), s.corrected.end());
+      all.raw.insert(all.raw.end(), s.raw.begin(), s.raw.end());
+    }
+    return all;
+  };
+  auto all_reads = merge(reads);
+  auto all_writes = merge(writes);
+  bricks::perf_sample total_perf;
+  for (const auto& sample : perf) {
+    total_perf += sample;
+  }
+  const auto* perf_columns = opts.perf != 0 ? &total_perf : nullptr;
+  const auto operations = all_reads.corrected.size() + all_writes.corrected.size();
+  print_row(Lock::name, cfg, "read", all_reads, elapsed, perf_columns, operations);
+  print_row(Lock::name, cfg, "write", all_writes, elapsed, perf_columns, operations);
+}
+
+// Powers of two below `max_threads`, then `max_threads` itself, e.g. 1, 2, 4, 6 for 6.
+auto thread_counts(unsigned max_threads) -> std::vector<unsigned>
+{
+  std::vector<unsigned> counts;
+  for (unsigned threads = 1; threads < max_threads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(max_threads);
+  return counts;
+}
+
+template <typename Lock>
+auto sweep(const options& opts) -> void
+{
+  for (const auto threads : thread_counts(opts.max_threads)) {
+    for (const auto read_ratio : {0.5, 0.9, 0.99}) {
+      for (const auto critical_section : {nanoseconds{0}, nanoseconds{100}, nanoseconds{1000}}) {
+        run<Lock>(opts, {threads, read_ratio, critical_section});
+      }
+    }
+  }
+}
+
+auto parse_options(int argc, char** argv) -> options
+{
+  options opts;
+  for (int i = 1; i < argc; i += 2) {
+    const std::string_view flag{argv[i]};
+    if (i + 1 == argc) throw std::invalid_argument{"missing value for " + std::string{flag}};
+    const std::string_view value{argv[i + 1]};
+    if (flag == "--duration-ms") {
+      opts.duration = std::chrono::milliseconds{
+          bricks::from_string<std::int64_t>(value)
+              .and_then([](std::int64_t ms) -> bricks::result<std::int64_t, std::errc> {
+                if (ms <= 0) return std::errc::invalid_argument;
+                return ms;
+              })
+              .expect("invalid --duration-ms, must be positive")};
+    } else if (flag == "--rate") {
+      opts.rate = bricks::from_string<std::uint64_t>(value).expect("invalid --rate");
+    } else if (flag == "--max-threads") {
+      opts.max_threads = bricks::from_string<unsigned>(value).expect("invalid --max-threads");
+    } else if (flag == "--perf") {
+      opts.perf = bricks::from_string<unsigned>(value).expect("invalid --perf, must be 0 or 1");
+    } else {
+      throw std::invalid_argument{"unknown flag " + std::string{flag}};
+    }
+  }
+  // At most one operation per nanosecond, so the schedule's period is never zero.
+  opts.rate = std::clamp<std::uint64_t>(opts.rate, 1, max_rate);
+  opts.max_threads = std::clamp(opts.max_threads, 1U, max_thread_count);
+
+  // Computed in floating point, so huge durations cannot overflow before they are rejected.
+  const auto operations = std::chrono::duration<double>{opts.duration} /
+                          std::chrono::duration<double>{schedule_period(opts)} *
+                          opts.max_threads;
+  if (operations > max_samples) {
+    std::array<char, 160> message{};
+    std::snprintf(message.data(), message.size(),
+                  "--rate, --duration-ms and --max-threads give %.3g operations per "
+                  "configuration, at most %.0f are allowed",
+                  operations, max_samples);
+    throw std::invalid_argument{message.data()};
+  }
+  return opts;
+}
+
+}  // namespace
+
+auto main(int argc, char** argv) -> int
+{
+  options opts;
+  try {
+    opts = parse_options(argc, argv);
+  } catch (const std::exception& e) {
+    std::fprintf(stderr, "lock_stress: %s\n%s\n", e.what(), usage);
+    return 2;
+  }
+
+  if (opts.perf != 0 && !bricks::perf_counters{}.available()) {
+    std::fprintf(stderr, "hardware counters are not available, the perf columns are zero\n");
+  }
+
+  std::printf(
+      "lock,threads,read_ratio,critical_section_ns,operation,samples,throughput_ops_s,p50_ns,p90_"
+      "ns,p99_ns,p999_ns,max_ns,uncorrected_p999_ns%s\n",
+      opts.perf != 0 ? ",ipc,cache_misses_per_op" : "");
+  sweep<mutex_adapter>(opts);
+  sweep<rw_lock_adapter>(opts);
+  return 0;
+}
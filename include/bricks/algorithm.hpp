@@ -1,16 +1,52 @@
 #pragma once
 
+#include <cstddef>
 #include <functional>
 #include <future>
 #include <string>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "bricks/detail/contains.hpp"
 #include "bricks/detail/index_of.hpp"
+#include "bricks/small_vector.hpp"
+#include "bricks/type_traits.hpp"
 
 namespace bricks {
 
+namespace detail {
+
+/**
+ * @brief Move the `Index`th element of every entry of a map into `out`, emptying the map.
+ *
+ * Node based maps are drained with `extract`, which frees every node right after its element was
+ * moved, so the memory does not double at the peak. Their keys are only movable that way, too.
+ */
+template <std::size_t Index, class Output, class Container>
+void drain_into(Output& out, Container& input_map)
+{
+  out.reserve(input_map.size());
+  if constexpr (has_extract<Container>::value) {
+    while (!input_map.empty()) {
+      auto node = input_map.extract(input_map.begin());
+      if constexpr (Index == 0) {
+        out.push_back(std::move(node.key()));
+      } else {
+        out.push_back(std::move(node.mapped()));
+      }
+    }
+  } else {
+    for (auto&& pair : input_map) {
+      out.push_back(std::get<Index>(std::move(pair)));
+    }
+    input_map.clear();
+  }
+}
+
+}  // namespace detail
+
 /**
  * @brief Get the keys of an associative container.
  *
@@ -53,6 +89,104 @@ auto values(const Container& input_map) -> std::vector<typename Container::mappe
   return retval;
 }
 
+/**
+ * @brief Move the keys out of an associative container.
+ *
+ * The keys are moved instead of copied, node based containers like `std::map` are drained with
+ * `extract`. The container is empty afterwards.
+ *
+ * Example:
+ * @snippet algorithm_test.cpp keys-move-example
+ *
+ * @tparam Container The type of the container.
+ * @param input_map The container.
+ * @return std::vector<typename Container::key_type> The keys.
+ */
+template <class Container,
+          typename std::enable_if_t<
+              !std::is_reference_v<Container> && !std::is_const_v<Container>, bool> = true>
+auto keys(Container&& input_map) -> std::vector<typename Container::key_type>
+{
+  std::vector<typename Container::key_type> retval;
+  detail::drain_into<0>(retval, input_map);
+
+  return retval;
+}
+
+/**
+ * @brief Move the values out of an associative container.
+ *
+ * The values are moved instead of copied, node based containers like `std::map` are drained with
+ * `extract`, which frees every node right away. The container is empty afterwards.
+ *
+ * Example:
+ * @snippet algorithm_test.cpp values-move-example
+ *
+ * @tparam Container The type of the container.
+ * @param input_map The container.
+ * @return std::vector<typename Container::mapped_type> The values.
+ */
+template <class Container,
+          typename std::enable_if_t<
+              !std::is_reference_v<Container> && !std::is_const_v<Container>, bool> = true>
+auto values(Container&& input_map) -> std::vector<typename Container::mapped_type>
+{
+  std::vector<typename Container::mapped_type> retval;
+  detail::drain_into<1>(retval, input_map);
+
+  return retval;
+}
+
+/**
+ * @brief Get the keys of an associative container into a `small_vector`.
+ *
+ * Up to `N` keys are stored inline, so getting the keys of a small map does not allocate.
+ *
+ * Example:
+ * @snippet algorithm_test.cpp keys-small_vector-example
+ *
+ * @tparam N The number of keys stored inline.
+ * @tparam Container The type of the container.
+ * @param input_map The container.
+ * @return small_vector<typename Container::key_type, N> The keys.
+ */
+template <std::size_t N, class Container>
+auto keys(const Container& input_map) -> small_vector<typename Container::key_type, N>
+{
+  small_vector<typename Container::key_type, N> retval;
+  retval.reserve(input_map.size());
+  for (auto&& pair : input_map) {
+    retval.push_back(std::get<0>(pair));
+  }
+
+  return retval;
+}
+
+/**
+ * @brief Get the values of an associative container into a `small_vector`.
+ *
+ * Up to `N` values are stored inline, so getting the values of a small map does not allocate.
+ *
+ * Example:
+ * @snippet algorithm_test.cpp values-small_vector-example
+ *
+ * @tparam N The number of values stored inline.
+ * @tparam Container The type of the container.
+ * @param input_map The container.
+ * @return small_vector<typename Container::mapped_type, N> The values.
+ */
+template <std::size_t N, class Container>
+auto values(const Container& input_map) -> small_vector<typename Container::mapped_type, N>
+{
+  small_vector<typename Container::mapped_type, N> retval;
+  retval.reserve(input_map.size());
+  for (auto&& pair : input_map) {
+    retval.push_back(std::get<1>(pair));
+  }
+
+  return retval;
+}
+
 /**
  * @brief Bind arguments to the front of a function.
  *
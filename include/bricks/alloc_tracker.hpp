@@ -0,0 +1,342 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace bricks {
+
+/**
+ * @brief Heap allocation counts.
+ */
+struct alloc_stats {
+  /** @brief Number of allocations. */
+  std::size_t allocations{0};
+  /** @brief Number of deallocations. */
+  std::size_t deallocations{0};
+  /** @brief Number of bytes requested by the allocations. */
+  std::size_t bytes{0};
+
+  [[nodiscard]] friend constexpr auto operator-(const alloc_stats& lhs,
+                                                const alloc_stats& rhs) noexcept -> alloc_stats
+  {
+    return {lhs.allocations - rhs.allocations, lhs.deallocations - rhs.deallocations,
+            lhs.bytes - rhs.bytes};
+  }
+};
+
+namespace detail {
+
+struct alloc_tag_entry {
+  std::atomic<const char*> tag{nullptr};
+  std::atomic<std::size_t> allocations{0};
+  std::atomic<std::size_t> bytes{0};
+};
+
+constexpr std::size_t alloc_tag_capacity = 64;
+
+inline bool alloc_hook_installed = false;
+inline thread_local alloc_stats thread_alloc_stats{};
+inline thread_local const char* current_alloc_tag = nullptr;
+inline std::array<alloc_tag_entry, alloc_tag_capacity> alloc_tag_table{};
+
+/**
+ * @brief Find or insert the table entry of a tag, without allocating or locking.
+ */
+inline auto alloc_tag_entry_for(const char* tag) noexcept -> alloc_tag_entry*
+{
+  const auto hash = reinterpret_cast<std::uintptr_t>(tag) >> 3U;  // NOLINT
+  for (std::size_t i = 0; i < alloc_tag_capacity; ++i) {
+    auto& entry = alloc_tag_table[(hash + i) % alloc_tag_capacity];
+    const char* current = entry.tag.load(std::memory_order_acquire);
+    if (current == nullptr &&
+        entry.tag.compare_exchange_strong(current, tag, std::memory_order_acq_rel)) {
+      return &entry;
+    }
+    // Either occupied or we lost the race for it, `current` holds the owner's tag in both cases.
+    if (current == tag) return &entry;
+  }
+  return nullptr;
+}
+
+inline auto record_allocation(std::size_t size) noexcept -> void
+{
+  auto& stats = thread_alloc_stats;
+  ++stats.allocations;
+  stats.bytes += size;
+
+  if (const char* tag = current_alloc_tag) {
+    if (auto* entry = alloc_tag_entry_for(tag)) {
+      entry->allocations.fetch_add(1, std::memory_order_relaxed);
+      entry->bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+  }
+}
+
+inline auto record_deallocation() noexcept -> void { ++thread_alloc_stats.deallocations; }
+
+}  // namespace detail
+
+/**
+ * @brief Check whether the global `operator new` hook is linked into the program.
+ *
+ * The hook is defined by including this header with `BRICKS_ALLOC_TRACKING_IMPLEMENTATION` defined
+ * in exactly one translation unit. Without it, only `counting_allocator` allocations are counted.
+ *
+ * @return true If the hook is installed.
+ */
+inline auto alloc_tracking_installed() noexcept -> bool { return detail::alloc_hook_installed; }
+
+/**
+ * @brief The allocation counts of the calling thread since it started.
+ */
+inline auto thread_alloc_stats() noexcept -> alloc_stats { return detail::thread_alloc_stats; }
+
+/**
+ * @brief Counts the allocations made by the calling thread during its lifetime.
+ *
+ * Example:
+ * @snippet alloc_tracker_test.cpp allocation_counter-example
+ */
+class allocation_counter {
+ public:
+  /** @brief Start counting. */
+  allocation_counter() noexcept : start_(detail::thread_alloc_stats) {}
+
+  /** @brief The counts since construction. */
+  [[nodiscard]] auto stats() const noexcept -> alloc_stats
+  {
+    return detail::thread_alloc_stats - start_;
+  }
+
+  /** @brief The number of allocations since construction. */
+  [[nodiscard]] auto allocations() const noexcept -> std::size_t { return stats().allocations; }
+
+  /** @brief The number of bytes allocated since construction. */
+  [[nodiscard]] auto bytes() const noexcept -> std::size_t { return stats().bytes; }
+
+ private:
+  alloc_stats start_;
+};
+
+/**
+ * @brief Count the allocations made by a function.
+ *
+ * Handy to assert allocation-free hot paths in tests.
+ *
+ * Example:
+ * @snippet alloc_tracker_test.cpp count_allocations-example
+ *
+ * @param f The function to call on the calling thread.
+ * @return alloc_stats The allocations `f` made.
+ */
+template <typename F>
+auto count_allocations(F&& f) -> alloc_stats
+{
+  const allocation_counter counter;
+  std::forward<F>(f)();
+  return counter.stats();
+}
+
+/**
+ * @brief Attributes the allocations made by the calling thread to a call-site tag.
+ *
+ * Tags nest, the innermost one wins. Tags are compared by address, so use string literals. The
+ * number of distinct tags is limited to 64, allocations of further tags are not attributed.
+ *
+ * Example:
+ * @snippet alloc_tracker_test.cpp alloc_tag-example
+ */
+class alloc_tag {
+ public:
+  /**
+   * @brief Make `tag` the current tag of the calling thread.
+   *
+   * @param tag The tag, must have static storage duration.
+   */
+  explicit alloc_tag(const char* tag) noexcept
+      : previous_(std::exchange(detail::current_alloc_tag, tag))
+  {
+  }
+
+  alloc_tag(const alloc_tag&) = delete;
+  auto operator=(const alloc_tag&) -> alloc_tag& = delete;
+  alloc_tag(alloc_tag&&) = delete;
+  auto operator=(alloc_tag&&) -> alloc_tag& = delete;
+
+  /** @brief Restore the previous tag. */
+  ~alloc_tag() { detail::current_alloc_tag = previous_; }
+
+ private:
+  const char* previous_;
+};
+
+/**
+ * @brief The allocations attributed to each tag so far, from all threads.
+ *
+ * Example:
+ * @snippet alloc_tracker_test.cpp alloc_tag-example
+ *
+ * @return std::vector<std::pair<const char*, alloc_stats>> The tags and their allocations.
+ */
+inline auto alloc_tag_report() -> std::vector<std::pair<const char*, alloc_stats>>
+{
+  std::vector<std::pair<const char*, alloc_stats>> report;
+  for (const auto& entry : detail::alloc_tag_table) {
+    if (const char* tag = entry.tag.load(std::memory_order_acquire)) {
+      report.emplace_back(tag, alloc_stats{entry.allocations.load(std::memory_order_relaxed), 0,
+                                           entry.bytes.load(std::memory_order_relaxed)});
+    }
+  }
+  return report;
+}
+
+/**
+ * @brief An allocator counting its allocations like the global hook does.
+ *
+ * Useful to track single containers without replacing the global `operator new`.
+ *
+ * Example:
+ * @snippet alloc_tracker_test.cpp counting_allocator-example
+ *
+ * @tparam T The value type.
+ * @tparam Allocator The allocator to forward to.
+ */
+template <typename T, typename Allocator = std::allocator<T>>
+class counting_allocator : public Allocator {
+  using traits = std::allocator_traits<Allocator>;
+
+ public:
+  using value_type = T;
+
+  template <typename U>
+  struct rebind {
+    using other = counting_allocator<U, typename traits::template rebind_alloc<U>>;
+  };
+
+  counting_allocator() = default;
+
+  template <typename U, typename A>
+  // cppcheck-suppress noExplicitConstructor
+  counting_allocator(const counting_allocator<U, A>& other) noexcept  // NOLINT
+      : Allocator(static_cast<const A&>(other))
+  {
+  }
+
+  [[nodiscard]] auto allocate(std::size_t n) -> T*
+  {
+    if (!detail::alloc_hook_installed) detail::record_allocation(n * sizeof(T));
+    return traits::allocate(*this, n);
+  }
+
+  auto deallocate(T* p, std::size_t n) noexcept -> void
+  {
+    if (!detail::alloc_hook_installed) detail::record_deallocation();
+    traits::deallocate(*this, p, n);
+  }
+};
+
+}  // namespace bricks
+
+#ifdef BRICKS_ALLOC_TRACKING_IMPLEMENTATION
+
+namespace bricks::detail {
+
+inline auto tracked_alloc(std::size_t size, std::size_t alignment) -> void*
+{
+  record_allocation(size);
+  if (size == 0) size = 1;
+  while (true) {
+    void* p = alignment <= alignof(std::max_align_t)
+                  ? std::malloc(size)
+                  : std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if (p != nullptr) return p;
+    if (auto handler = std::get_new_handler()) {
+      handler();
+    } else {
+      throw std::bad_alloc{};
+    }
+  }
+}
+
+inline auto tracked_free(void* p) noexcept -> void
+{
+  if (p != nullptr) record_deallocation();
+  std::free(p);  // NOLINT
+}
+
+// Runs during static initialization of the implementing translation unit.
+[[maybe_unused]] inline const bool alloc_hook_registered = (alloc_hook_installed = true);
+
+}  // namespace bricks::detail
+
+// NOLINTBEGIN
+auto operator new(std::size_t size) -> void* { return bricks::detail::tracked_alloc(size, 0); }
+auto operator new[](std::size_t size) -> void* { return bricks::detail::tracked_alloc(size, 0); }
+auto operator new(std::size_t size, std::align_val_t al) -> void*
+{
+  return bricks::detail::tracked_alloc(size, static_cast<std::size_t>(al));
+}
+auto operator new[](std::size_t size, std::align_val_t al) -> void*
+{
+  return bricks::detail::tracked_alloc(size, static_cast<std::size_t>(al));
+}
+auto operator new(std::size_t size, const std::nothrow_t& /* unused */) noexcept -> void*
+{
+  try {
+    return bricks::detail::tracked_alloc(size, 0);
+  } catch (...) {
+    return nullptr;
+  }
+}
+auto operator new[](std::size_t size, const std::nothrow_t& /* unused */) noexcept -> void*
+{
+  try {
+    return bricks::detail::tracked_alloc(size, 0);
+  } catch (...) {
+    return nullptr;
+  }
+}
+void operator delete(void* p) noexcept { bricks::detail::tracked_free(p); }
+void operator delete[](void* p) noexcept { bricks::detail::tracked_free(p); }
+void operator delete(void* p, std::size_t /* unused */) noexcept
+{
+  bricks::detail::tracked_free(p);
+}
+void operator delete[](void* p, std::size_t /* unused */) noexcept
+{
+  bricks::detail::tracked_free(p);
+}
+void operator delete(void* p, std::align_val_t /* unused */) noexcept
+{
+  bricks::detail::tracked_free(p);
+}
+void operator delete[](void* p, std::align_val_t /* unused */) noexcept
+{
+  bricks::detail::tracked_free(p);
+}
+void operator delete(void* p, std::size_t /* unused */, std::align_val_t /* unused */) noexcept
+{
+  bricks::detail::tracked_free(p);
+}
+void operator delete[](void* p, std::size_t /* unused */, std::align_val_t /* unused */) noexcept
+{
+  bricks::detail::tracked_free(p);
+}
+void operator delete(void* p, const std::nothrow_t& /* unused */) noexcept
+{
+  bricks::detail::tracked_free(p);
+}
+void operator delete[](void* p, const std::nothrow_t& /* unused */) noexcept
+{
+  bricks::detail::tracked_free(p);
+}
+// NOLINTEND
+
+#endif
@@ -5,15 +5,78 @@
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
+#include "detail/digits.hpp"
+#include "enum.hpp"
+#include "fixed_string.hpp"
 #include "result.hpp"
+#include "timestamp.hpp"
 
 namespace bricks {
 
+namespace detail {
+
+/**
+ * @brief The maximum number of characters of the shortest representation of a floating point type.
+ *
+ * Shortest round-trip output is never longer than its scientific form: sign, `max_digits10`
+ * digits, decimal point, `e`, exponent sign and exponent digits.
+ */
+template <typename Float>
+inline constexpr std::size_t max_floating_size =
+    1 + std::numeric_limits<Float>::max_digits10 + 1 + 2 +
+    count_digits(static_cast<unsigned>(std::numeric_limits<Float>::max_exponent10));
+
+template <typename T>
+constexpr auto max_chars() noexcept -> std::size_t
+{
+  if constexpr (std::is_floating_point_v<T>) {
+    return max_floating_size<T>;
+  } else {
+    return max_integer_size<T>;
+  }
+}
+
+}  // namespace detail
+
+/**
+ * @brief Convert a number to a string without allocating.
+ *
+ * The result is stored inline, in a `fixed_string` sized for the longest representation of `T`.
+ * Integers are converted in constant expressions as well, floating point numbers use the shortest
+ * representation that round-trips, like `std::to_chars`. The conversion cannot fail.
+ *
+ * Example:
+ * @snippet charconv_test.cpp to_fixed_string-example
+ *
+ * @tparam T The type of number to convert.
+ * @param value The number to convert.
+ * @return fixed_string The decimal representation of `value`.
+ */
+template <typename T>
+constexpr auto to_fixed_string(const T& value) noexcept -> fixed_string<detail::max_chars<T>()>
+{
+  static_assert(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>,
+                "to_fixed_string expects an integral or floating point type.");
+
+  fixed_string<detail::max_chars<T>()> str;
+  if constexpr (std::is_integral_v<T>) {
+    str.resize(static_cast<std::size_t>(detail::write_integer(str.data(), value) - str.data()));
+  } else {
+    const auto [ptr, ec] = std::to_chars(str.data(), str.data() + str.capacity(), value);
+    str.resize(ec == std::errc{} ? static_cast<std::size_t>(ptr - str.data()) : 0);
+  }
+  return str;
+}
+
 /**
  * @brief Exceptionlessly convert a number to a string.
  *
  * This function is a wrapper around `std::to_chars` and will return the same error codes.
+ * Enumerations with `enum_traits` are converted to their name with `enum_to_string`, system clock
+ * time points to ISO-8601 with `format_timestamp`.
  *
  * Example:
  * @snippet charconv_test.cpp to_string-example
@@ -31,15 +94,55 @@ auto to_string(const T& value,
                std::size_t buffer_size = (std::numeric_limits<T>::digits10 + 2)) noexcept
     -> result<std::string, std::errc>
 {
-  std::string str(buffer_size, '\0');
-  auto [ptr, ec] = std::to_chars(str.data(), str.data() + str.size(), value);
+  if constexpr (std::is_enum_v<T>) {
+    return enum_to_string(value).map(
+        [](std::string_view name) { return std::string{name.data(), name.size()}; });
+  } else if constexpr (detail::is_sys_time_v<T>) {
+    return format_timestamp(value);
+  } else if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+    // Avoids zero-filling a buffer, the size is known up front.
+    if (detail::integer_size(value) > buffer_size) return std::errc::value_too_large;
+    const auto chars = to_fixed_string(value);
+    return std::string{chars.data(), chars.size()};
+  } else {
+    std::string str(buffer_size, '\0');
+    auto [ptr, ec] = std::to_chars(str.data(), str.data() + str.size(), value);
+
+    if (ec != std::errc()) {
+      return ec;
+    }
+
+    str.resize(std::distance(str.data(), ptr));
+    return str;
+  }
+}
+
+/**
+ * @brief Exceptionlessly parse a number from the start of a string.
+ *
+ * Unlike `from_string`, trailing characters are not an error. Instead the number of consumed
+ * characters is returned, so consecutive fields can be parsed from one buffer without slicing it
+ * first. This function is a wrapper around `std::from_chars` and will return the same error codes.
+ *
+ * Example:
+ * @snippet charconv_test.cpp parse_prefix-example
+ *
+ * @tparam T The type of number to parse.
+ * @param str The string to parse from.
+ * @return result<std::pair<T, std::size_t>, std::errc> The number and the number of characters it
+ *         consumed, or the error code if no number could be parsed.
+ */
+template <typename T>
+auto parse_prefix(std::string_view str) noexcept -> result<std::pair<T, std::size_t>, std::errc>
+{
+  T value{};
+  auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
 
   if (ec != std::errc()) {
     return ec;
   }
 
-  str.resize(std::distance(str.data(), ptr));
-  return str;
+  return std::pair<T, std::size_t>{value, static_cast<std::size_t>(ptr - str.data())};
 }
 
 /**
@@ -48,6 +151,8 @@ auto to_string(const T& value,
  * This function is a wrapper around `std::from_chars` and will return the same error codes.
  * It, however, will return `std::errc::invalid_argument` if the string contains
  * characters that are not part of the number.
+ * Enumerations with `enum_traits` are parsed from their name with `enum_from_string`, system clock
+ * time points from ISO-8601 with `parse_timestamp`.
  *
  * Example:
  * @snippet charconv_test.cpp from_string-example
@@ -60,18 +165,24 @@ auto to_string(const T& value,
 template <typename T>
 auto from_string(const std::string_view& str) noexcept -> result<T, std::errc>
 {
-  T value;
-  auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+  if constexpr (std::is_enum_v<T>) {
+    return enum_from_string<T>(str);
+  } else if constexpr (detail::is_sys_time_v<T>) {
+    return parse_timestamp<typename T::duration>(str);
+  } else {
+    T value;
+    auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
 
-  if (ec != std::errc()) {
-    return ec;
-  }
+    if (ec != std::errc()) {
+      return ec;
+    }
 
-  if (ptr != str.data() + str.size()) {
-    return std::errc::invalid_argument;
-  }
+    if (ptr != str.data() + str.size()) {
+      return std::errc::invalid_argument;
+    }
 
-  return value;
+    return value;
+  }
 }
 
 }  // namespace bricks
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+// BRICKS_SIMD_NONE disables all SIMD kernels, BRICKS_SIMD_NATIVE selects them at compile time from
+// the target flags, e.g. -march=native. Otherwise they are selected at runtime. The meson option
+// `simd` sets these.
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(BRICKS_SIMD_NONE)
+#define BRICKS_CPU_X86 1
+#endif
+
+namespace bricks {
+
+/**
+ * @brief The instruction set extensions of the CPU the program runs on.
+ *
+ * Detected with `cpuid`, which includes checking that the operating system saves the AVX
+ * registers. All are `false` on other architectures or if SIMD is disabled with
+ * `BRICKS_SIMD_NONE`.
+ *
+ * Example:
+ * @snippet cpu_features_test.cpp cpu_features-example
+ */
+struct cpu_features {
+  bool sse2{false};
+  bool ssse3{false};
+  bool sse4_2{false};
+  bool popcnt{false};
+  bool avx2{false};
+  bool bmi2{false};
+  bool avx512f{false};
+  bool avx512bw{false};
+
+  /**
+   * @brief Detect the features of this CPU.
+   */
+  [[nodiscard]] static auto detect() noexcept -> cpu_features
+  {
+    cpu_features features;
+#ifdef BRICKS_CPU_X86
+    __builtin_cpu_init();
+    features.sse2 = __builtin_cpu_supports("sse2");
+    features.ssse3 = __builtin_cpu_supports("ssse3");
+    features.sse4_2 = __builtin_cpu_supports("sse4.2");
+    features.popcnt = __builtin_cpu_supports("popcnt");
+    features.avx2 = __builtin_cpu_supports("avx2");
+    features.bmi2 = __builtin_cpu_supports("bmi2");
+    features.avx512f = __builtin_cpu_supports("avx512f");
+    features.avx512bw = __builtin_cpu_supports("avx512bw");
+#endif
+    return features;
+  }
+
+  /**
+   * @brief The features of this CPU, detected once on first use.
+   */
+  [[nodiscard]] static auto current() noexcept -> const cpu_features&
+  {
+    static const cpu_features features = detect();
+    return features;
+  }
+};
+
+/**
+ * @brief The levels of x86 instruction set extensions kernels are written for, in ascending order.
+ */
+enum class cpu_target : unsigned char { scalar, ssse3, avx2, avx512 };
+
+/**
+ * @brief The highest target the kernels may use.
+ *
+ * With `BRICKS_SIMD_NATIVE` it is the highest target enabled at compile time, otherwise the
+ * highest one this CPU supports.
+ */
+[[nodiscard]] inline auto best_cpu_target() noexcept -> cpu_target
+{
+#if !defined(BRICKS_CPU_X86)
+  return cpu_target::scalar;
+#elif defined(BRICKS_SIMD_NATIVE)
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+  return cpu_target::avx512;
+#elif defined(__AVX2__)
+  return cpu_target::avx2;
+#elif defined(__SSSE3__)
+  return cpu_target::ssse3;
+#else
+  return cpu_target::scalar;
+#endif
+#else
+  const auto& features = cpu_features::current();
+  if (features.avx512f && features.avx512bw) return cpu_target::avx512;
+  if (features.avx2) return cpu_target::avx2;
+  if (features.ssse3) return cpu_target::ssse3;
+  return cpu_target::scalar;
+#endif
+}
+
+template <typename Signature>
+class cpu_dispatch;
+
+/**
+ * @brief A table of kernels for different targets, calling the best one this CPU supports.
+ *
+ * The kernel is resolved on the first call and cached in an atomic function pointer, so later
+ * calls cost one indirect call. Kernels for higher targets are usually compiled with
+ * `__attribute__((target("...")))`, so they work in headers without per-file compiler flags.
+ *
+ * Example:
+ * @snippet cpu_features_test.cpp cpu_dispatch-example
+ *
+ * @tparam R The return type of the kernels.
+ * @tparam Args The parameter types of the kernels.
+ */
+template <typename R, typename... Args>
+class cpu_dispatch<R(Args...)> {
+ public:
+  using function_type = R (*)(Args...);
+
+  /**
+   * @brief Create a table. Missing kernels are `nullptr`, the next lower one is used instead.
+   */
+  constexpr cpu_dispatch(function_type scalar, function_type ssse3 = nullptr,
+                         function_type avx2 = nullptr, function_type avx512 = nullptr) noexcept
+      : kernels_{scalar, ssse3, avx2, avx512}
+  {
+  }
+
+  /**
+   * @brief Call the best kernel.
+   */
+  auto operator()(Args... args) const -> R { return resolve()(std::forward<Args>(args)...); }
+
+  /**
+   * @brief The best kernel for `best_cpu_target()`, resolved on the first call.
+   */
+  [[nodiscard]] auto resolve() const noexcept -> function_type
+  {
+    auto* kernel = resolved_.load(std::memory_order_relaxed);
+    if (kernel == nullptr) {
+      kernel = select(best_cpu_target());
+      resolved_.store(kernel, std::memory_order_relaxed);
+    }
+    return kernel;
+  }
+
+  /**
+   * @brief The kernel for the highest target up to `max` that has one.
+   */
+  [[nodiscard]] constexpr auto select(cpu_target max) const noexcept -> function_type
+  {
+    for (auto i = static_cast<std::size_t>(max); i > 0; --i) {
+      if (kernels_[i] != nullptr) return kernels_[i];
+    }
+    return kernels_[0];
+  }
+
+ private:
+  std::array<function_type, 4> kernels_;
+  mutable std::atomic<function_type> resolved_{nullptr};
+};
+
+}  // namespace bricks
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <future>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "charconv.hpp"
+#include "detail/encoding_simd.hpp"
+#include "result.hpp"
+
+namespace bricks {
+
+/**
+ * @brief The error of a failed CSV parse.
+ */
+struct csv_error {
+  /** @brief The index of the record, not counting the header and empty lines. */
+  std::size_t row;
+  /** @brief The index of the field in the record. */
+  std::size_t column;
+  /**
+   * @brief The error of the field conversion, or `std::errc::invalid_argument` if the record has
+   * too few or too many fields.
+   */
+  std::errc code;
+
+  [[nodiscard]] friend constexpr auto operator==(const csv_error& lhs,
+                                                  const csv_error& rhs) noexcept -> bool
+  {
+    return lhs.row == rhs.row && lhs.column == rhs.column && lhs.code == rhs.code;
+  }
+  [[nodiscard]] friend constexpr auto operator!=(const csv_error& lhs,
+                                                  const csv_error& rhs) noexcept -> bool
+  {
+    return !(lhs == rhs);
+  }
+};
+
+namespace detail {
+
+/**
+ * @brief Find the next delimiter or newline at or after `pos`, 16 bytes at a time with SSE2.
+ *
+ * @return std::size_t Its position, or `size` if there is none.
+ */
+inline auto find_csv_separator(const char* data, std::size_t size, std::size_t pos,
+                               char delimiter) noexcept -> std::size_t
+{
+#ifdef BRICKS_ENCODING_X86
+  const __m128i delimiters = _mm_set1_epi8(delimiter);
+  const __m128i newlines = _mm_set1_epi8('\n');
+  for (; pos + 16 <= size; pos += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));  // NOLINT
+    const auto mask = static_cast<unsigned>(_mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, newlines))));
+    if (mask != 0) return pos + static_cast<std::size_t>(__builtin_ctz(mask));
+  }
+#endif
+  for (; pos < size; ++pos) {
+    if (data[pos] == delimiter || data[pos] == '\n') return pos;
+  }
+  return size;
+}
+
+/**
+ * @brief The position after the newline ending the line that contains `pos`, or `size`.
+ */
+inline auto next_line(std::string_view input, std::size_t pos) noexcept -> std::size_t
+{
+  if (pos >= input.size()) return input.size();
+  const auto* newline =
+      static_cast<const char*>(std::memchr(input.data() + pos, '\n', input.size() - pos));
+  return newline == nullptr ? input.size() : static_cast<std::size_t>(newline - input.data()) + 1;
+}
+
+}  // namespace detail
+
+/**
+ * @brief A parser of delimiter separated records into typed columns.
+ *
+ * Every record has one field per type in `Ts`, converted with `from_string`, or kept as
+ * `std::string_view` or copied to `std::string`. The fields are stored column wise, in a tuple of
+ * vectors, so the columns can be iterated together with `zip`.
+ *
+ * Delimiters and newlines are found 16 bytes at a time with SSE2. Records end with `\n` or `\r\n`,
+ * empty lines are skipped. Quoting is not supported, so fields cannot contain the delimiter or
+ * newlines.
+ *
+ * Example:
+ * @snippet csv_test.cpp csv_reader-example
+ *
+ * @tparam Ts The types of the fields of a record.
+ */
+template <typename... Ts>
+class csv_reader {
+  static_assert(sizeof...(Ts) > 0, "A record needs at least one field.");
+
+ public:
+  /** @brief The parsed columns, one vector per field. */
+  using columns_type = std::tuple<std::vector<Ts>...>;
+
+  /**
+   * @brief Create a reader.
+   *
+   * @param delimiter The separator between fields, e.g. `','` for CSV or `'\t'` for TSV.
+   * @param has_header Whether to skip the first line of the input.
+   */
+  explicit csv_reader(char delimiter = ',', bool has_header = false) noexcept
+      : delimiter_(delimiter), has_header_(has_header)
+  {
+  }
+
+  /**
+   * @brief Parse all records of the input.
+   *
+   * `std::string_view` fields point into `input`, which has to outlive them.
+   *
+   * @param input The text to parse.
+   * @return result<columns_type, csv_error> The columns, or the position and cause of the first
+   *         error.
+   */
+  [[nodiscard]] auto parse(std::string_view input) const -> result<columns_type, csv_error>
+  {
+    return parse_body(input.substr(body_start(input)));
+  }
+
+  /**
+   * @brief Parse all records of the input, splitting it into chunks parsed in parallel.
+   *
+   * The input is split at line boundaries into `chunks` parts of about equal size. All but the
+   * first are parsed with `std::async`, then the columns are concatenated in order. The result is
+   * the same as the one of `parse(input)`, errors report the row within the whole input.
+   *
+   * Example:
+   * @snippet csv_test.cpp csv_reader-parallel-example
+   *
+   * @param input The text to parse.
+   * @param chunks The number of chunks, one parses the input on the calling thread.
+   * @return result<columns_type, csv_error> The columns, or the position and cause of the first
+   *         error.
+   */
+  [[nodiscard]] auto parse(std::string_view input, std::size_t chunks) const
+      -> result<columns_type, csv_error>
+  {
+    const auto body = input.substr(body_start(input));
+    std::vector<chunk> parts;
+    std::size_t start = 0;
+    for (std::size_t i = 1; i <= chunks && start < body.size(); ++i) {
+      const auto end =
+          i == chunks ? body.size() : detail::next_line(body, body.size() / chunks * i);
+      if (end <= start) continue;
+      parts.push_back(chunk{body.substr(start, end - start)});
+      start = end;
+    }
+    if (parts.size() <= 1) return parse_body(body);
+
+    std::vector<std::future<bool>> futures;
+    futures.reserve(parts.size() - 1);
+    for (std::size_t i = 1; i < parts.size(); ++i) {
+      futures.push_back(
+          std::async(std::launch::async, [this, &part = parts[i]] { return parse_chunk(part); }));
+    }
+    parse_chunk(parts.front());
+    for (auto& future : futures) {
+      future.get();
+    }
+
+    std::size_t rows = 0;
+    for (auto& part : parts) {
+      if (part.error.code != std::errc{}) {
+        part.error.row += rows;
+        return part.error;
+      }
+      rows += std::get<0>(part.columns).size();
+    }
+
+    columns_type columns;
+    std::apply([rows](auto&... column) { (column.reserve(rows), ...); }, columns);
+    for (auto& part : parts) {
+      append_columns(columns, part.columns, std::index_sequence_for<Ts...>{});
+    }
+    return columns;
+  }
+
+ private:
+  struct chunk {
+    std::string_view input;
+    columns_type columns{};
+    csv_error error{};
+  };
+
+  [[nodiscard]] auto body_start(std::string_view input) const noexcept -> std::size_t
+  {
+    return has_header_ ? detail::next_line(input, 0) : 0;
+  }
+
+  [[nodiscard]] auto parse_body(std::string_view body) const -> result<columns_type, csv_error>
+  {
+    chunk whole{body};
+    if (!parse_chunk(whole)) return whole.error;
+    return std::move(whole.columns);
+  }
+
+  /**
+   * @brief Parse the records of `out.input` into `out.columns`, counting them in `out.error.row`.
+   */
+  auto parse_chunk(chunk& out) const -> bool
+  {
+    const auto input = out.input;
+    std::size_t pos = 0;
+    while (pos < input.size()) {
+      if (input[pos] == '\n' || input.substr(pos, 2) == "\r\n") {
+        pos = detail::next_line(input, pos);
+        continue;
+      }
+      if (!parse_record(input, pos, out, std::index_sequence_for<Ts...>{})) return false;
+      ++out.error.row;
+    }
+    return true;
+  }
+
+  template <std::size_t... Index>
+  auto parse_record(std::string_view input, std::size_t& pos, chunk& out,
+                    std::index_sequence<Index...> /* unused */) const -> bool
+  {
+    return (parse_field<Index>(input, pos, out) && ...);
+  }
+
+  template <std::size_t Column>
+  auto parse_field(std::string_view input, std::size_t& pos, chunk& out) const -> bool
+  {
+    using type = std::tuple_element_t<Column, std::tuple<Ts...>>;
+    constexpr bool last = Column + 1 == sizeof...(Ts);
+
+    const auto end = detail::find_csv_separator(input.data(), input.size(), pos, delimiter_);
+    const bool at_delimiter = end < input.size() && input[end] == delimiter_;
+    if (at_delimiter == last) {
+      // A missing field is reported at its own column, a surplus one after the last column.
+      out.error.column = Column + 1;
+      out.error.code = std::errc::invalid_argument;
+      return false;
+    }
+
+    auto field = input.substr(pos, end - pos);
+    if (last && !field.empty() && field.back() == '\r') field.remove_suffix(1);
+    pos = end + 1;
+
+    auto& column = std::get<Column>(out.columns);
+    if constexpr (std::is_same_v<type, std::string_view>) {
+      column.push_back(field);
+    } else if constexpr (std::is_same_v<type, std::string>) {
+      column.emplace_back(field.data(), field.size());
+    } else {
+      const auto value = from_string<type>(field);
+      if (value.is_error()) {
+        out.error.column = Column;
+        out.error.code = value.unwrap_error();
+        return false;
+      }
+      column.push_back(value.unwrap());
+    }
+    return true;
+  }
+
+  template <std::size_t... Index>
+  static void append_columns(columns_type& columns, columns_type& chunk,
+                             std::index_sequence<Index...> /* unused */)
+  {
+    (std::get<Index>(columns).insert(std::get<Index>(columns).end(),
+                                     std::make_move_iterator(std::get<Index>(chunk).begin()),
+                                     std::make_move_iterator(std::get<Index>(chunk).end())),
+     ...);
+  }
+
+  char delimiter_;
+  bool has_header_;
+};
+
+}  // namespace bricks
@@ -4,6 +4,7 @@
 #include <string>
 #include <type_traits>
 
+#include "bricks/detail/find.hpp"
 #include "bricks/type_traits.hpp"
 
 namespace bricks::detail {
@@ -11,14 +12,27 @@ namespace bricks::detail {
 /**
  * @brief Implementation of `contains`.
  */
-template <class Container, typename std::enable_if_t<
-                               !has_find_v<Container, typename Container::value_type>, bool> = true>
+template <class Container,
+          typename std::enable_if_t<!has_find_v<Container, typename Container::value_type> &&
+                                        !is_searchable_range_v<Container>,
+                                    bool> = true>
 constexpr auto contains(const Container& container,
                         const typename Container::value_type& value) noexcept -> bool
 {
   return std::find(std::begin(container), std::end(container), value) != std::end(container);
 }
 
+/**
+ * @brief Specialization for contiguous bitwise comparable elements, searched with memchr or SIMD.
+ */
+template <class Container,
+          typename std::enable_if_t<is_searchable_range_v<Container>, bool> = true>
+auto contains(const Container& container, const typename Container::value_type& value) noexcept
+    -> bool
+{
+  return find_value(std::data(container), std::size(container), value) != std::size(container);
+}
+
 /**
  * @brief Specialization for containers that have a `find` method.
  */
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+namespace bricks::detail {
+
+constexpr auto make_digit_pairs() noexcept -> std::array<char, 200>
+{
+  std::array<char, 200> pairs{};
+  for (std::size_t i = 0; i < 100; ++i) {
+    pairs[2 * i] = static_cast<char>('0' + i / 10);
+    pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+  }
+  return pairs;
+}
+
+/**
+ * @brief The decimal representations of 00 to 99, used to emit two digits per division.
+ */
+inline constexpr auto digit_pairs = make_digit_pairs();
+
+/**
+ * @brief Number of decimal digits of an unsigned integer.
+ */
+template <typename UInt>
+constexpr auto count_digits(UInt value) noexcept -> std::size_t
+{
+  static_assert(std::is_unsigned_v<UInt>, "count_digits expects an unsigned type");
+  std::size_t digits = 1;
+  while (true) {
+    if (value < 10U) return digits;
+    if (value < 100U) return digits + 1;
+    if (value < 1000U) return digits + 2;
+    if (value < 10000U) return digits + 3;
+    value /= 10000U;
+    digits += 4;
+  }
+}
+
+/**
+ * @brief Write the digits of an unsigned integer so that the last one ends right before `last`.
+ */
+template <typename UInt>
+constexpr auto write_digits_backwards(char* last, UInt value) noexcept -> void
+{
+  static_assert(std::is_unsigned_v<UInt>, "write_digits_backwards expects an unsigned type");
+  while (value >= 100U) {
+    const auto pair = static_cast<std::size_t>(value % 100U) * 2;
+    value /= 100U;
+    *--last = digit_pairs[pair + 1];
+    *--last = digit_pairs[pair];
+  }
+  if (value >= 10U) {
+    const auto pair = static_cast<std::size_t>(value) * 2;
+    *--last = digit_pairs[pair + 1];
+    *--last = digit_pairs[pair];
+  } else {
+    *--last = static_cast<char>('0' + value);
+  }
+}
+
+/**
+ * @brief The magnitude of an integer as its unsigned counterpart, well defined for the minimum.
+ */
+template <typename Int>
+constexpr auto unsigned_magnitude(Int value) noexcept -> std::make_unsigned_t<Int>
+{
+  using uint_t = std::make_unsigned_t<Int>;
+  if constexpr (std::is_signed_v<Int>) {
+    return value < 0 ? static_cast<uint_t>(uint_t{0} - static_cast<uint_t>(value))
+                     : static_cast<uint_t>(value);
+  } else {
+    return value;
+  }
+}
+
+/**
+ * @brief Number of characters of the decimal representation of an integer, including the sign.
+ */
+template <typename Int>
+constexpr auto integer_size(Int value) noexcept -> std::size_t
+{
+  const std::size_t sign = std::is_signed_v<Int> && value < 0 ? 1 : 0;
+  return sign + count_digits(unsigned_magnitude(value));
+}
+
+/**
+ * @brief Write the decimal representation of an integer to `first`, which must have room for
+ * `integer_size(value)` characters.
+ *
+ * @return char* One past the last written character.
+ */
+template <typename Int>
+constexpr auto write_integer(char* first, Int value) noexcept -> char*
+{
+  const auto size = integer_size(value);
+  if constexpr (std::is_signed_v<Int>) {
+    if (value < 0) *first = '-';
+  }
+  write_digits_backwards(first + size, unsigned_magnitude(value));
+  return first + size;
+}
+
+/**
+ * @brief The maximum number of characters of the decimal representation of an integer type.
+ */
+template <typename Int>
+inline constexpr std::size_t max_integer_size =
+    std::numeric_limits<Int>::digits10 + 1 + (std::is_signed_v<Int> ? 1 : 0);
+
+}  // namespace bricks::detail
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+
+#include "bricks/cpu_features.hpp"
+
+#ifdef BRICKS_CPU_X86
+#define BRICKS_ENCODING_X86 1
+#include <immintrin.h>
+#endif
+
+namespace bricks::detail {
+
+#ifdef BRICKS_ENCODING_X86
+
+// The kernels below process whole blocks and return how much of the input they consumed, the
+// scalar code finishes the tail.
+
+/**
+ * @brief Look up the hex digits of the nibbles of 16 bytes and interleave them into 32 chars.
+ */
+__attribute__((target("ssse3"))) inline auto hex_encode_ssse3(const unsigned char* in,
+                                                              std::size_t size, char* out) noexcept
+    -> std::size_t
+{
+  const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b',
+                                       'c', 'd', 'e', 'f');
+  const __m128i low_mask = _mm_set1_epi8(0x0f);
+
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    const __m128i high =
+        _mm_shuffle_epi8(digits, _mm_and_si128(_mm_srli_epi16(bytes, 4), low_mask));
+    const __m128i low = _mm_shuffle_epi8(digits, _mm_and_si128(bytes, low_mask));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i),  // NOLINT
+                     _mm_unpacklo_epi8(high, low));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * i + 16),  // NOLINT
+                     _mm_unpackhi_epi8(high, low));
+  }
+  return i;
+}
+
+/**
+ * @brief Like `hex_encode_ssse3`, 32 bytes at a time.
+ *
+ * The unpack instructions work per 128-bit lane, so the halves are put back in order afterwards. A
+ * remaining half block is encoded with `hex_encode_ssse3`.
+ */
+__attribute__((target("avx2"))) inline auto hex_encode_avx2(const unsigned char* in,
+                                                            std::size_t size, char* out) noexcept
+    -> std::size_t
+{
+  const __m256i digits =
+      _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e',
+                       'f', '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd',
+                       'e', 'f');
+  const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+  std::size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));  // NOLINT
+    const __m256i high =
+        _mm256_shuffle_epi8(digits, _mm256_and_si256(_mm256_srli_epi16(bytes, 4), low_mask));
+    const __m256i low = _mm256_shuffle_epi8(digits, _mm256_and_si256(bytes, low_mask));
+    const __m256i first = _mm256_unpacklo_epi8(high, low);
+    const __m256i second = _mm256_unpackhi_epi8(high, low);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i),  // NOLINT
+                        _mm256_permute2x128_si256(first, second, 0x20));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * i + 32),  // NOLINT
+                        _mm256_permute2x128_si256(first, second, 0x31));
+  }
+  return i + hex_encode_ssse3(in + i, size - i, out + 2 * i);
+}
+
+/**
+ * @brief Decode 16 hex digits into 8 bytes at a time.
+ *
+ * Stops before the first block containing a character that is not a hex digit, so the scalar code
+ * can report the error.
+ */
+__attribute__((target("ssse3"))) inline auto hex_decode_ssse3(const char* in, std::size_t size,
+                                                              unsigned char* out) noexcept
+    -> std::size_t
+{
+  const __m128i zero = _mm_set1_epi8('0');
+  const __m128i lower_a = _mm_set1_epi8('a');
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i nine = _mm_set1_epi8(9);
+  const __m128i five = _mm_set1_epi8(5);
+  const __m128i ten = _mm_set1_epi8(10);
+  // Multiplies the high nibble of each pair by 16 and adds the low one.
+  const __m128i weights = _mm_set1_epi16(0x0110);
+
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    const __m128i digit = _mm_sub_epi8(chars, zero);
+    const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, case_bit), lower_a);
+    const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, nine), digit);
+    const __m128i is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, five), letter);
+    if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_letter)) != 0xffff) break;
+
+    const __m128i nibbles = _mm_or_si128(_mm_and_si128(is_digit, digit),
+                                         _mm_andnot_si128(is_digit, _mm_add_epi8(letter, ten)));
+    const __m128i pairs = _mm_maddubs_epi16(nibbles, weights);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i / 2),  // NOLINT
+                     _mm_packus_epi16(pairs, pairs));
+  }
+  return i;
+}
+
+/**
+ * @brief Encode 12 bytes into 16 base64 characters at a time.
+ *
+ * Uses the multiply based bit reshuffling and the `pshufb` offset lookup described by Wojciech
+ * Muła and Daniel Lemire. Loads 16 bytes per block, so 4 bytes past the last block must be
+ * readable.
+ *
+ * @param c62 The character encoding 62.
+ * @param c63 The character encoding 63.
+ */
+__attribute__((target("ssse3"))) inline auto base64_encode_ssse3(const unsigned char* in,
+                                                                 std::size_t size, char* out,
+                                                                 char c62, char c63) noexcept
+    -> std::size_t
+{
+  const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+  const __m128i offsets =
+      _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                    '0' - 52, '0' - 52, '0' - 52, '0' - 52, static_cast<char>(c62 - 62),
+                    static_cast<char>(c63 - 63), 'A', 0, 0);
+
+  std::size_t i = 0;
+  std::size_t o = 0;
+  for (; i + 16 <= size; i += 12, o += 16) {
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    bytes = _mm_shuffle_epi8(bytes, shuffle);
+
+    // Move the four 6-bit groups of every 3 byte triple into their own byte.
+    const __m128i t0 = _mm_and_si128(bytes, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(bytes, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    // Map 0..25 to 13, 26..51 to 0, 52..61 to 1..10, 62 to 11 and 63 to 12, then add the offset of
+    // that range.
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i upper = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(upper, _mm_set1_epi8(13)));
+    const __m128i chars = _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + o), chars);  // NOLINT
+  }
+  return i;
+}
+
+/**
+ * @brief The 6-bit values of 16 base64 characters, and whether all of them are in the alphabet.
+ *
+ * Letters and digits are found with range checks, the last two characters of the alphabet with
+ * comparisons, so one kernel serves both alphabets.
+ */
+__attribute__((target("ssse3"))) inline auto base64_values_ssse3(__m128i chars, char c62,
+                                                                 char c63, bool& valid) noexcept
+    -> __m128i
+{
+  const __m128i upper = _mm_sub_epi8(chars, _mm_set1_epi8('A'));
+  const __m128i lower = _mm_sub_epi8(chars, _mm_set1_epi8('a'));
+  const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+  const __m128i is_upper = _mm_cmpeq_epi8(_mm_min_epu8(upper, _mm_set1_epi8(25)), upper);
+  const __m128i is_lower = _mm_cmpeq_epi8(_mm_min_epu8(lower, _mm_set1_epi8(25)), lower);
+  const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+  const __m128i is_62 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(c62));
+  const __m128i is_63 = _mm_cmpeq_epi8(chars, _mm_set1_epi8(c63));
+
+  const __m128i any = _mm_or_si128(_mm_or_si128(is_upper, is_lower),
+                                   _mm_or_si128(is_digit, _mm_or_si128(is_62, is_63)));
+  valid = _mm_movemask_epi8(any) == 0xffff;
+
+  __m128i values = _mm_and_si128(is_upper, upper);
+  values = _mm_or_si128(values, _mm_and_si128(is_lower, _mm_add_epi8(lower, _mm_set1_epi8(26))));
+  values = _mm_or_si128(values, _mm_and_si128(is_digit, _mm_add_epi8(digit, _mm_set1_epi8(52))));
+  values = _mm_or_si128(values, _mm_and_si128(is_62, _mm_set1_epi8(62)));
+  return _mm_or_si128(values, _mm_and_si128(is_63, _mm_set1_epi8(63)));
+}
+
+/**
+ * @brief Decode 16 base64 characters into 12 bytes at a time.
+ *
+ * The inverse of `base64_encode_ssse3`: `pmaddubsw` merges pairs of 6-bit values into 12 bits,
+ * `pmaddwd` merges those into the 24 bits of a triple, and `pshufb` puts its bytes in order. Stops
+ * before the first block containing a character that is not in the alphabet, or padding, so the
+ * scalar code can report the error.
+ *
+ * @param c62 The character encoding 62.
+ * @param c63 The character encoding 63.
+ */
+__attribute__((target("ssse3"))) inline auto base64_decode_ssse3(const char* in, std::size_t size,
+                                                                 unsigned char* out, char c62,
+                                                                 char c63) noexcept -> std::size_t
+{
+  const __m128i pair_weights = _mm_set1_epi32(0x01400140);
+  const __m128i triple_weights = _mm_set1_epi32(0x00011000);
+  const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    bool valid = false;
+    const __m128i values = base64_values_ssse3(chars, c62, c63, valid);
+    if (!valid) break;
+
+    const __m128i pairs = _mm_maddubs_epi16(values, pair_weights);
+    const __m128i triples = _mm_madd_epi16(pairs, triple_weights);
+    const __m128i bytes = _mm_shuffle_epi8(triples, shuffle);
+    unsigned char* const block = out + i / 4 * 3;
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(block), bytes);  // NOLINT
+    const auto rest = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+    std::memcpy(block + 8, &rest, 4);
+  }
+  return i;
+}
+
+/**
+ * @brief Like `base64_decode_ssse3`, 32 characters into 24 bytes at a time.
+ *
+ * The 12 bytes of each 128-bit lane are moved next to each other before storing. A remaining half
+ * block is decoded with `base64_decode_ssse3`.
+ */
+__attribute__((target("avx2"))) inline auto base64_decode_avx2(const char* in, std::size_t size,
+                                                               unsigned char* out, char c62,
+                                                               char c63) noexcept -> std::size_t
+{
+  const __m256i pair_weights = _mm256_set1_epi32(0x01400140);
+  const __m256i triple_weights = _mm256_set1_epi32(0x00011000);
+  const __m256i shuffle =
+      _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4,
+                       10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+  const __m256i compact = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+
+  std::size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));  // NOLINT
+    bool low_valid = false;
+    bool high_valid = false;
+    const __m128i low = base64_values_ssse3(_mm256_castsi256_si128(chars), c62, c63, low_valid);
+    const __m128i high =
+        base64_values_ssse3(_mm256_extracti128_si256(chars, 1), c62, c63, high_valid);
+    if (!low_valid || !high_valid) break;
+
+    const __m256i values = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+    const __m256i pairs = _mm256_maddubs_epi16(values, pair_weights);
+    const __m256i triples = _mm256_madd_epi16(pairs, triple_weights);
+    const __m256i bytes =
+        _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(triples, shuffle), compact);
+    unsigned char* const block = out + i / 4 * 3;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(block),  // NOLINT
+                     _mm256_castsi256_si128(bytes));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(block + 16),  // NOLINT
+                     _mm256_extracti128_si256(bytes, 1));
+  }
+  return i + base64_decode_ssse3(in + i, size - i, out + i / 4 * 3, c62, c63);
+}
+
+#else
+
+inline auto hex_encode_ssse3(const unsigned char* /* in */, std::size_t /* size */,
+                             char* /* out */) noexcept -> std::size_t
+{
+  return 0;
+}
+
+inline auto hex_encode_avx2(const unsigned char* /* in */, std::size_t /* size */,
+                            char* /* out */) noexcept -> std::size_t
+{
+  return 0;
+}
+
+inline auto hex_decode_ssse3(const char* /* in */, std::size_t /* size */,
+                             unsigned char* /* out */) noexcept -> std::size_t
+{
+  return 0;
+}
+
+inline auto base64_encode_ssse3(const unsigned char* /* in */, std::size_t /* size */,
+                                char* /* out */, char /* c62 */, char /* c63 */) noexcept
+    -> std::size_t
+{
+  return 0;
+}
+
+inline auto base64_decode_ssse3(const char* /* in */, std::size_t /* size */,
+                                unsigned char* /* out */, char /* c62 */, char /* c63 */) noexcept
+    -> std::size_t
+{
+  return 0;
+}
+
+inline auto base64_decode_avx2(const char* /* in */, std::size_t /* size */,
+                               unsigned char* /* out */, char /* c62 */, char /* c63 */) noexcept
+    -> std::size_t
+{
+  return 0;
+}
+
+#endif
+
+using hex_encode_kernel = std::size_t(const unsigned char*, std::size_t, char*);
+using hex_decode_kernel = std::size_t(const char*, std::size_t, unsigned char*);
+using base64_encode_kernel = std::size_t(const unsigned char*, std::size_t, char*, char, char);
+using base64_decode_kernel = std::size_t(const char*, std::size_t, unsigned char*, char, char);
+
+/**
+ * @brief The scalar entry of the kernel tables, which leaves all of the input to the scalar code.
+ */
+template <typename In, typename Out, typename... Alphabet>
+inline auto no_blocks(In /* in */, std::size_t /* size */, Out /* out */,
+                      Alphabet... /* alphabet */) noexcept -> std::size_t
+{
+  return 0;
+}
+
+// The functions below encode or decode whole blocks with the best kernel for this CPU and return
+// how much of the input they consumed.
+
+inline auto hex_encode_blocks(const unsigned char* in, std::size_t size, char* out) noexcept
+    -> std::size_t
+{
+  static const cpu_dispatch<hex_encode_kernel> kernels{
+      no_blocks<const unsigned char*, char*>, hex_encode_ssse3, hex_encode_avx2};
+  return kernels(in, size, out);
+}
+
+inline auto hex_decode_blocks(const char* in, std::size_t size, unsigned char* out) noexcept
+    -> std::size_t
+{
+  static const cpu_dispatch<hex_decode_kernel> kernels{no_blocks<const char*, unsigned char*>,
+                                                       hex_decode_ssse3};
+  return kernels(in, size, out);
+}
+
+inline auto base64_encode_blocks(const unsigned char* in, std::size_t size, char* out, char c62,
+                                 char c63) noexcept -> std::size_t
+{
+  static const cpu_dispatch<base64_encode_kernel> kernels{
+      no_blocks<const unsigned char*, char*, char, char>, base64_encode_ssse3};
+  return kernels(in, size, out, c62, c63);
+}
+
+inline auto base64_decode_blocks(const char* in, std::size_t size, unsigned char* out, char c62,
+                                 char c63) noexcept -> std::size_t
+{
+  static const cpu_dispatch<base64_decode_kernel> kernels{
+      no_blocks<const char*, unsigned char*, char, char>, base64_decode_ssse3, base64_decode_avx2};
+  return kernels(in, size, out, c62, c63);
+}
+
+}  // namespace bricks::detail
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+#include "bricks/cpu_features.hpp"
+#include "bricks/simd.hpp"
+#include "bricks/type_traits.hpp"
+
+namespace bricks::detail {
+
+template <typename Container, typename = void>
+struct is_searchable_range : std::false_type {
+};
+
+/**
+ * @brief Whether a container stores bitwise comparable elements of 1, 2, 4 or 8 bytes contiguously
+ *        and has no `find` of its own, so it can be searched with `find_value`.
+ */
+template <typename Container>
+struct is_searchable_range<Container, std::enable_if_t<is_contiguous_range_v<const Container>>>
+    : std::bool_constant<is_bitwise_comparable_v<range_value_t<const Container>> &&
+                         (sizeof(range_value_t<const Container>) == 1 ||
+                          sizeof(range_value_t<const Container>) == 2 ||
+                          sizeof(range_value_t<const Container>) == 4 ||
+                          sizeof(range_value_t<const Container>) == 8) &&
+                         !has_find_v<Container, range_value_t<const Container>>> {
+};
+
+template <typename Container>
+inline constexpr bool is_searchable_range_v = is_searchable_range<Container>::value;
+
+template <std::size_t Size>
+struct unsigned_of_size;
+
+template <>
+struct unsigned_of_size<1> {
+  using type = std::uint8_t;
+};
+
+template <>
+struct unsigned_of_size<2> {
+  using type = std::uint16_t;
+};
+
+template <>
+struct unsigned_of_size<4> {
+  using type = std::uint32_t;
+};
+
+template <>
+struct unsigned_of_size<8> {
+  using type = std::uint64_t;
+};
+
+/**
+ * @brief Find the first element equal to `value`, one vector at a time, the tail one by one.
+ *
+ * The elements are compared by their bytes, as unsigned integers of the same size.
+ *
+ * @return std::size_t The index of the value, or `size` if there is none.
+ */
+template <typename Vector, typename T>
+auto find_lane(const T* data, std::size_t size, T value) noexcept -> std::size_t
+{
+  using lane = typename Vector::value_type;
+  static_assert(sizeof(lane) == sizeof(T));
+
+  lane bits{};
+  std::memcpy(&bits, &value, sizeof(bits));
+  const auto needle = Vector::broadcast(bits);
+  std::size_t i = 0;
+  for (; i + Vector::size() <= size; i += Vector::size()) {
+    const auto* lanes = reinterpret_cast<const lane*>(data + i);  // NOLINT
+    const auto matches = (Vector::load(lanes) == needle).to_bitmask();
+    if (matches != 0) return i + first_lane(matches);
+  }
+  for (; i < size; ++i) {
+    if (data[i] == value) return i;
+  }
+  return size;
+}
+
+template <typename T>
+using lanes_of_t = typename unsigned_of_size<sizeof(T)>::type;
+
+template <typename T>
+auto find_value_16(const T* data, std::size_t size, T value) noexcept -> std::size_t
+{
+  return find_lane<simd<lanes_of_t<T>, 16 / sizeof(T)>>(data, size, value);
+}
+
+#ifdef BRICKS_CPU_X86
+template <typename T>
+__attribute__((target("avx2"), flatten)) auto find_value_avx2(const T* data, std::size_t size,
+                                                             T value) noexcept -> std::size_t
+{
+  return find_lane<simd<lanes_of_t<T>, 32 / sizeof(T), simd_abi::avx2>>(data, size, value);
+}
+#endif
+
+/**
+ * @brief The index of the first element equal to `value`, or `size` if there is none.
+ *
+ * Single bytes are found with `memchr`. Wider elements are compared 16 bytes at a time, with SSE2
+ * on x86-64, or 32 bytes with AVX2 if the CPU supports it.
+ */
+template <typename T>
+auto find_value(const T* data, std::size_t size, T value) noexcept -> std::size_t
+{
+  static_assert(is_bitwise_comparable_v<T>);
+  if constexpr (sizeof(T) == 1) {
+    unsigned char byte = 0;
+    std::memcpy(&byte, &value, 1);
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);  // NOLINT
+    const auto* found = static_cast<const unsigned char*>(std::memchr(bytes, byte, size));
+    return found == nullptr ? size : static_cast<std::size_t>(found - bytes);
+  } else {
+#ifdef BRICKS_CPU_X86
+    static const cpu_dispatch<std::size_t(const T*, std::size_t, T)> kernels{
+        find_value_16<T>, nullptr, find_value_avx2<T>};
+    return kernels(data, size, value);
+#else
+    return find_value_16(data, size, value);
+#endif
+  }
+}
+
+}  // namespace bricks::detail
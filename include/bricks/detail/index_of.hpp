@@ -4,6 +4,7 @@
 #include <optional>
 #include <string>
 
+#include "bricks/detail/find.hpp"
 #include "bricks/type_traits.hpp"
 
 namespace bricks::detail {
@@ -13,7 +14,9 @@ namespace bricks::detail {
  */
 template <class Container,
           typename std::enable_if_t<
-              std::negation_v<has_find<Container, typename Container::value_type>>, bool> = true>
+              std::conjunction_v<std::negation<has_find<Container, typename Container::value_type>>,
+                                 std::negation<is_searchable_range<Container>>>,
+              bool> = true>
 constexpr auto index_of(const Container& container,
                         const typename Container::value_type& value) noexcept
     -> std::optional<std::size_t>
@@ -23,6 +26,19 @@ constexpr auto index_of(const Container& container,
                                    : std::nullopt;
 }
 
+/**
+ * @brief Specialization for contiguous bitwise comparable elements, searched with memchr or SIMD.
+ */
+template <class Container,
+          typename std::enable_if_t<is_searchable_range_v<Container>, bool> = true>
+auto index_of(const Container& container, const typename Container::value_type& value) noexcept
+    -> std::optional<std::size_t>
+{
+  const auto size = std::size(container);
+  const auto pos = find_value(std::data(container), size, value);
+  return pos != size ? std::make_optional(pos) : std::nullopt;
+}
+
 /**
  * @brief Specialization for containers that have a `find` method.
  */
@@ -2,6 +2,8 @@
 
 #include <shared_mutex>
 
+#include "bricks/trace.hpp"
+
 namespace bricks::detail {
 
 template <typename T>
@@ -10,6 +12,11 @@ class read_guard {
   read_guard(const T& this_in, std::shared_mutex& mutex_in) noexcept
       : this_(this_in), mutex_(mutex_in)
   {
+    // Only waiting is traced, uncontended acquisitions would crowd the other spans out of the ring.
+    if constexpr (trace_enabled) {
+      if (mutex_.try_lock_shared()) return;
+    }
+    BRICKS_TRACE_SCOPE("bricks::read_guard wait");
     mutex_.lock_shared();
   }
 
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+namespace bricks::detail {
+
+/**
+ * @brief Load eight characters into a word, the first character in the lowest byte.
+ */
+inline auto load_eight_chars(const char* chars) noexcept -> std::uint64_t
+{
+  std::uint64_t word = 0;
+  std::memcpy(&word, chars, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  word = __builtin_bswap64(word);
+#endif
+  return word;
+}
+
+/**
+ * @brief Check whether all eight characters of a word are decimal digits.
+ *
+ * Every byte must look like `0x3?`, and adding 6 must not carry into the high nibble.
+ */
+constexpr auto is_eight_digits(std::uint64_t word) noexcept -> bool
+{
+  return ((word & 0xF0F0F0F0F0F0F0F0U) |
+          (((word + 0x0606060606060606U) & 0xF0F0F0F0F0F0F0F0U) >> 4U)) == 0x3333333333333333U;
+}
+
+/**
+ * @brief Convert eight decimal digits, loaded by `load_eight_chars`, to their value.
+ *
+ * Combines neighbouring digits into pairs, then pairs into quadruples, using three
+ * multiplications instead of eight.
+ */
+constexpr auto parse_eight_digits(std::uint64_t word) noexcept -> std::uint32_t
+{
+  constexpr std::uint64_t mask = 0x000000FF000000FFU;
+  constexpr std::uint64_t mul1 = 100U + (1000000ULL << 32U);
+  constexpr std::uint64_t mul2 = 1U + (10000ULL << 32U);
+
+  word -= 0x3030303030303030U;
+  word = (word * 10U) + (word >> 8U);
+  word = (((word & mask) * mul1) + (((word >> 16U) & mask) * mul2)) >> 32U;
+  return static_cast<std::uint32_t>(word);
+}
+
+}  // namespace bricks::detail
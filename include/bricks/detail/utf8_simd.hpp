@@ -0,0 +1,370 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "encoding_simd.hpp"
+
+namespace bricks::detail {
+
+/**
+ * @brief Move back from `pos` to the first byte of the character that contains `pos - 1`.
+ *
+ * Kernels validate whole blocks, so a character may be cut off at the end of the last block. The
+ * scalar code restarts at the returned position and sees the whole character.
+ */
+inline auto rewind_to_char_start(const unsigned char* in, std::size_t pos) noexcept -> std::size_t
+{
+  std::size_t start = pos;
+  while (start > 0 && pos - start < 3 && (in[start - 1] & 0xc0U) == 0x80U) {
+    --start;
+  }
+  if (start > 0 && in[start - 1] >= 0xc0U) --start;
+  return start;
+}
+
+#ifdef BRICKS_ENCODING_X86
+
+/**
+ * @brief The length of the prefix made of whole 16 byte ASCII blocks, at most `size`.
+ */
+inline auto ascii_prefix_sse2(const unsigned char* in, std::size_t size) noexcept -> std::size_t
+{
+  std::size_t i = 0;
+  for (; i + 64 <= size; i += 64) {
+    const auto* block = reinterpret_cast<const __m128i*>(in + i);  // NOLINT
+    const __m128i bits =
+        _mm_or_si128(_mm_or_si128(_mm_loadu_si128(block), _mm_loadu_si128(block + 1)),
+                     _mm_or_si128(_mm_loadu_si128(block + 2), _mm_loadu_si128(block + 3)));
+    if (_mm_movemask_epi8(bits) != 0) break;
+  }
+  for (; i + 16 <= size; i += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    if (_mm_movemask_epi8(block) != 0) break;
+  }
+  return i;
+}
+
+/**
+ * @brief Like `ascii_prefix_sse2` with 32 byte blocks.
+ */
+__attribute__((target("avx2"))) inline auto ascii_prefix_avx2(const unsigned char* in,
+                                                              std::size_t size) noexcept
+    -> std::size_t
+{
+  std::size_t i = 0;
+  for (; i + 128 <= size; i += 128) {
+    const auto* block = reinterpret_cast<const __m256i*>(in + i);  // NOLINT
+    const __m256i bits = _mm256_or_si256(
+        _mm256_or_si256(_mm256_loadu_si256(block), _mm256_loadu_si256(block + 1)),
+        _mm256_or_si256(_mm256_loadu_si256(block + 2), _mm256_loadu_si256(block + 3)));
+    if (_mm256_movemask_epi8(bits) != 0) break;
+  }
+  for (; i + 32 <= size; i += 32) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));  // NOLINT
+    if (_mm256_movemask_epi8(block) != 0) break;
+  }
+  return i;
+}
+
+// Error classes of the Keiser-Lemire lookup algorithm, each bit flags one kind of invalid pair of
+// consecutive bytes. A pair is invalid if a bit is set in all three lookups.
+inline constexpr std::uint8_t utf8_too_short = 1U << 0U;
+inline constexpr std::uint8_t utf8_too_long = 1U << 1U;
+inline constexpr std::uint8_t utf8_overlong_3 = 1U << 2U;
+inline constexpr std::uint8_t utf8_too_large = 1U << 3U;
+inline constexpr std::uint8_t utf8_surrogate = 1U << 4U;
+inline constexpr std::uint8_t utf8_overlong_2 = 1U << 5U;
+inline constexpr std::uint8_t utf8_too_large_1000 = 1U << 6U;
+inline constexpr std::uint8_t utf8_overlong_4 = 1U << 6U;
+inline constexpr std::uint8_t utf8_two_conts = 1U << 7U;
+inline constexpr std::uint8_t utf8_carry = utf8_too_short | utf8_too_long | utf8_two_conts;
+
+inline constexpr std::array<std::uint8_t, 16> utf8_byte_1_high = {
+    utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long, utf8_too_long,
+    utf8_too_long, utf8_too_long, utf8_two_conts, utf8_two_conts, utf8_two_conts,
+    utf8_two_conts, utf8_too_short | utf8_overlong_2, utf8_too_short,
+    utf8_too_short | utf8_overlong_3 | utf8_surrogate,
+    utf8_too_short | utf8_too_large | utf8_too_large_1000 | utf8_overlong_4};
+
+inline constexpr std::array<std::uint8_t, 16> utf8_byte_1_low = {
+    utf8_carry | utf8_overlong_3 | utf8_overlong_2 | utf8_overlong_4, utf8_carry | utf8_overlong_2,
+    utf8_carry, utf8_carry, utf8_carry | utf8_too_large,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000 | utf8_surrogate,
+    utf8_carry | utf8_too_large | utf8_too_large_1000,
+    utf8_carry | utf8_too_large | utf8_too_large_1000};
+
+inline constexpr std::array<std::uint8_t, 16> utf8_byte_2_high = {
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_short, utf8_too_short, utf8_too_short,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large_1000 |
+        utf8_overlong_4,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_overlong_3 | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+    utf8_too_long | utf8_overlong_2 | utf8_two_conts | utf8_surrogate | utf8_too_large,
+    utf8_too_short, utf8_too_short, utf8_too_short, utf8_too_short};
+
+inline auto load_table(const std::array<std::uint8_t, 16>& table) noexcept -> __m128i
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.data()));  // NOLINT
+}
+
+/**
+ * @brief Validate 16 bytes at a time with the lookup algorithm of Keiser and Lemire.
+ *
+ * Every byte is classified together with its predecessor by three table lookups, and the third
+ * and fourth bytes of a sequence are checked to be continuations. Pure ASCII blocks only check
+ * that the previous block did not end in an incomplete character.
+ *
+ * @return std::size_t The offset the scalar validation has to continue from. Everything before is
+ *         valid, an error lies after it if the kernel found one.
+ */
+__attribute__((target("ssse3"))) inline auto validate_utf8_ssse3(const unsigned char* in,
+                                                                 std::size_t size) noexcept
+    -> std::size_t
+{
+  const __m128i byte_1_high_table = load_table(utf8_byte_1_high);
+  const __m128i byte_1_low_table = load_table(utf8_byte_1_low);
+  const __m128i byte_2_high_table = load_table(utf8_byte_2_high);
+  const __m128i low_nibble = _mm_set1_epi8(0x0f);
+  // The largest valid value of the last three bytes of a block without an incomplete character.
+  const __m128i incomplete_limit =
+      _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                    static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1),
+                    static_cast<char>(0xc0 - 1));
+
+  __m128i previous = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i input = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    __m128i error;
+    if (_mm_movemask_epi8(input) == 0) {
+      error = _mm_subs_epu8(previous, incomplete_limit);
+    } else {
+      const __m128i prev1 = _mm_alignr_epi8(input, previous, 15);
+      const __m128i byte_1_high = _mm_shuffle_epi8(
+          byte_1_high_table, _mm_and_si128(_mm_srli_epi16(prev1, 4), low_nibble));
+      const __m128i byte_1_low =
+          _mm_shuffle_epi8(byte_1_low_table, _mm_and_si128(prev1, low_nibble));
+      const __m128i byte_2_high = _mm_shuffle_epi8(
+          byte_2_high_table, _mm_and_si128(_mm_srli_epi16(input, 4), low_nibble));
+      const __m128i special = _mm_and_si128(_mm_and_si128(byte_1_high, byte_1_low), byte_2_high);
+
+      const __m128i prev2 = _mm_alignr_epi8(input, previous, 14);
+      const __m128i prev3 = _mm_alignr_epi8(input, previous, 13);
+      // Only bytes following a three or four byte lead get their top bit set.
+      const __m128i is_third = _mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80));
+      const __m128i is_fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+      const __m128i must_be_continuation =
+          _mm_and_si128(_mm_or_si128(is_third, is_fourth), _mm_set1_epi8(static_cast<char>(0x80)));
+      error = _mm_xor_si128(must_be_continuation, special);
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(error, _mm_setzero_si128())) != 0xffff) break;
+    previous = input;
+  }
+  return rewind_to_char_start(in, i);
+}
+
+/**
+ * @brief Like `validate_utf8_ssse3` with 32 byte blocks.
+ */
+__attribute__((target("avx2"))) inline auto validate_utf8_avx2(const unsigned char* in,
+                                                               std::size_t size) noexcept
+    -> std::size_t
+{
+  const __m256i byte_1_high_table =
+      _mm256_broadcastsi128_si256(load_table(utf8_byte_1_high));
+  const __m256i byte_1_low_table = _mm256_broadcastsi128_si256(load_table(utf8_byte_1_low));
+  const __m256i byte_2_high_table =
+      _mm256_broadcastsi128_si256(load_table(utf8_byte_2_high));
+  const __m256i low_nibble = _mm256_set1_epi8(0x0f);
+  const __m256i incomplete_limit = _mm256_setr_epi8(
+      -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+      -1, -1, -1, -1, -1, -1, static_cast<char>(0xf0 - 1), static_cast<char>(0xe0 - 1),
+      static_cast<char>(0xc0 - 1));
+
+  __m256i previous = _mm256_setzero_si256();
+  std::size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));  // NOLINT
+    __m256i error;
+    if (_mm256_movemask_epi8(input) == 0) {
+      error = _mm256_subs_epu8(previous, incomplete_limit);
+    } else {
+      // The high lane of `previous` followed by the low lane of `input`, so that `alignr` shifts
+      // bytes across the lane boundary.
+      const __m256i shifted = _mm256_permute2x128_si256(previous, input, 0x21);
+      const __m256i prev1 = _mm256_alignr_epi8(input, shifted, 15);
+      const __m256i byte_1_high = _mm256_shuffle_epi8(
+          byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), low_nibble));
+      const __m256i byte_1_low =
+          _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, low_nibble));
+      const __m256i byte_2_high = _mm256_shuffle_epi8(
+          byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), low_nibble));
+      const __m256i special =
+          _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+      const __m256i prev2 = _mm256_alignr_epi8(input, shifted, 14);
+      const __m256i prev3 = _mm256_alignr_epi8(input, shifted, 13);
+      const __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80));
+      const __m256i is_fourth =
+          _mm256_subs_epu8(prev3, _mm256_set1_epi8(static_cast<char>(0xf0 - 0x80)));
+      const __m256i must_be_continuation = _mm256_and_si256(
+          _mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(static_cast<char>(0x80)));
+      error = _mm256_xor_si256(must_be_continuation, special);
+    }
+    if (!_mm256_testz_si256(error, error)) break;
+    previous = input;
+  }
+  return rewind_to_char_start(in, i);
+}
+
+/**
+ * @brief Widen the leading ASCII blocks of UTF-8 to UTF-16, 16 characters at a time.
+ *
+ * @param size The number of input bytes, and at most the room of the output.
+ * @return std::size_t The number of converted characters.
+ */
+inline auto widen_ascii_sse2(const unsigned char* in, std::size_t size, char16_t* out) noexcept
+    -> std::size_t
+{
+  const __m128i zero = _mm_setzero_si128();
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    if (_mm_movemask_epi8(block) != 0) break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i),  // NOLINT
+                     _mm_unpacklo_epi8(block, zero));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8),  // NOLINT
+                     _mm_unpackhi_epi8(block, zero));
+  }
+  return i;
+}
+
+/**
+ * @brief Narrow the leading ASCII blocks of UTF-16 to UTF-8, 16 characters at a time.
+ *
+ * @param size The number of input code units, and at most the room of the output.
+ * @return std::size_t The number of converted characters.
+ */
+inline auto narrow_ascii_sse2(const char16_t* in, std::size_t size, char* out) noexcept
+    -> std::size_t
+{
+  const __m128i non_ascii = _mm_set1_epi16(static_cast<short>(0xff80));
+  std::size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));  // NOLINT
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i + 8));  // NOLINT
+    const __m128i bits = _mm_and_si128(_mm_or_si128(low, high), non_ascii);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(bits, _mm_setzero_si128())) != 0xffff) break;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(low, high));  // NOLINT
+  }
+  return i;
+}
+
+/**
+ * @brief Like `widen_ascii_sse2`, 32 characters at a time.
+ *
+ * A remaining half block is widened with `widen_ascii_sse2`.
+ */
+__attribute__((target("avx2"))) inline auto widen_ascii_avx2(const unsigned char* in,
+                                                             std::size_t size,
+                                                             char16_t* out) noexcept -> std::size_t
+{
+  std::size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));  // NOLINT
+    if (_mm256_movemask_epi8(block) != 0) break;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),  // NOLINT
+                        _mm256_cvtepu8_epi16(_mm256_castsi256_si128(block)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 16),  // NOLINT
+                        _mm256_cvtepu8_epi16(_mm256_extracti128_si256(block, 1)));
+  }
+  return i + widen_ascii_sse2(in + i, size - i, out + i);
+}
+
+/**
+ * @brief Like `narrow_ascii_sse2`, 32 characters at a time.
+ *
+ * The pack instruction works per 128-bit lane, so the quarters are put back in order afterwards.
+ * A remaining half block is narrowed with `narrow_ascii_sse2`.
+ */
+__attribute__((target("avx2"))) inline auto narrow_ascii_avx2(const char16_t* in,
+                                                              std::size_t size,
+                                                              char* out) noexcept -> std::size_t
+{
+  const __m256i non_ascii = _mm256_set1_epi16(static_cast<short>(0xff80));
+  std::size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i));  // NOLINT
+    const __m256i high =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + i + 16));  // NOLINT
+    if (!_mm256_testz_si256(_mm256_or_si256(low, high), non_ascii)) break;
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i),  // NOLINT
+                        _mm256_permute4x64_epi64(_mm256_packus_epi16(low, high), 0xd8));
+  }
+  return i + narrow_ascii_sse2(in + i, size - i, out + i);
+}
+
+#else
+
+inline auto ascii_prefix_sse2(const unsigned char* /* in */, std::size_t /* size */) noexcept
+    -> std::size_t
+{
+  return 0;
+}
+
+inline auto ascii_prefix_avx2(const unsigned char* /* in */, std::size_t /* size */) noexcept
+    -> std::size_t
+{
+  return 0;
+}
+
+inline auto validate_utf8_ssse3(const unsigned char* /* in */, std::size_t /* size */) noexcept
+    -> std::size_t
+{
+  return 0;
+}
+
+inline auto validate_utf8_avx2(const unsigned char* /* in */, std::size_t /* size */) noexcept
+    -> std::size_t
+{
+  return 0;
+}
+
+inline auto widen_ascii_sse2(const unsigned char* /* in */, std::size_t /* size */,
+                             char16_t* /* out */) noexcept -> std::size_t
+{
+  return 0;
+}
+
+inline auto narrow_ascii_sse2(const char16_t* /* in */, std::size_t /* size */,
+                              char* /* out */) noexcept -> std::size_t
+{
+  return 0;
+}
+
+inline auto widen_ascii_avx2(const unsigned char* /* in */, std::size_t /* size */,
+                             char16_t* /* out */) noexcept -> std::size_t
+{
+  return 0;
+}
+
+inline auto narrow_ascii_avx2(const char16_t* /* in */, std::size_t /* size */,
+                              char* /* out */) noexcept -> std::size_t
+{
+  return 0;
+}
+
+#endif
+
+}  // namespace bricks::detail
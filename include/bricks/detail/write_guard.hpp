@@ -2,6 +2,8 @@
 
 #include <type_traits>
 
+#include "bricks/trace.hpp"
+
 namespace bricks::detail {
 
 template <typename T, typename mutex_type>
@@ -9,6 +11,11 @@ class write_guard {
  public:
   write_guard(T& this_in, mutex_type& mutex_in) noexcept : this_(this_in), mutex_(mutex_in)
   {
+    // Only waiting is traced, uncontended acquisitions would crowd the other spans out of the ring.
+    if constexpr (trace_enabled) {
+      if (mutex_.try_lock()) return;
+    }
+    BRICKS_TRACE_SCOPE("bricks::write_guard wait");
     mutex_.lock();
   }
 
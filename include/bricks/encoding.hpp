@@ -0,0 +1,665 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "detail/encoding_simd.hpp"
+#include "result.hpp"
+
+namespace bricks {
+
+/**
+ * @brief The alphabets of base64, as defined by RFC 4648.
+ */
+enum class base64_alphabet {
+  /** @brief `A-Z a-z 0-9 + /`, padded with `=`. */
+  standard,
+  /** @brief `A-Z a-z 0-9 - _`, without padding, safe for URLs and file names. */
+  url,
+};
+
+namespace detail {
+
+inline constexpr std::string_view hex_digits = "0123456789abcdef";
+inline constexpr std::string_view base64_standard_chars =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+inline constexpr std::string_view base64_url_chars =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+inline constexpr std::string_view base32_chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+constexpr std::uint8_t invalid_code = 0xff;
+
+/**
+ * @brief The inverse of an alphabet, `invalid_code` for characters not in it.
+ */
+constexpr auto make_decode_table(std::string_view chars) noexcept
+    -> std::array<std::uint8_t, 256>
+{
+  std::array<std::uint8_t, 256> table{};
+  for (auto& code : table) {
+    code = invalid_code;
+  }
+  for (std::size_t i = 0; i < chars.size(); ++i) {
+    table[static_cast<unsigned char>(chars[i])] = static_cast<std::uint8_t>(i);
+  }
+  return table;
+}
+
+constexpr auto make_hex_decode_table() noexcept -> std::array<std::uint8_t, 256>
+{
+  auto table = make_decode_table(hex_digits);
+  for (std::size_t i = 10; i < 16; ++i) {
+    table[static_cast<unsigned char>('A' + (i - 10))] = static_cast<std::uint8_t>(i);
+  }
+  return table;
+}
+
+inline constexpr auto hex_decode_table = make_hex_decode_table();
+inline constexpr auto base64_standard_decode_table = make_decode_table(base64_standard_chars);
+inline constexpr auto base64_url_decode_table = make_decode_table(base64_url_chars);
+inline constexpr auto base32_decode_table = make_decode_table(base32_chars);
+
+constexpr auto base64_chars(base64_alphabet alphabet) noexcept -> std::string_view
+{
+  return alphabet == base64_alphabet::url ? base64_url_chars : base64_standard_chars;
+}
+
+inline auto as_bytes(std::string_view str) noexcept -> const unsigned char*
+{
+  return reinterpret_cast<const unsigned char*>(str.data());  // NOLINT
+}
+
+inline auto hex_encode(std::string_view in, char* out) noexcept -> char*
+{
+  const auto* bytes = as_bytes(in);
+  for (auto i = hex_encode_blocks(bytes, in.size(), out); i < in.size(); ++i) {
+    out[2 * i] = hex_digits[bytes[i] >> 4U];
+    out[2 * i + 1] = hex_digits[bytes[i] & 0x0fU];
+  }
+  return out + 2 * in.size();
+}
+
+inline auto hex_decode(std::string_view in, char* out) noexcept -> std::errc
+{
+  auto* bytes = reinterpret_cast<unsigned char*>(out);  // NOLINT
+  for (auto i = hex_decode_blocks(in.data(), in.size(), bytes); i < in.size(); i += 2) {
+    const auto high = hex_decode_table[static_cast<unsigned char>(in[i])];
+    const auto low = hex_decode_table[static_cast<unsigned char>(in[i + 1])];
+    if (high == invalid_code || low == invalid_code) return std::errc::invalid_argument;
+    bytes[i / 2] = static_cast<unsigned char>((high << 4U) | low);
+  }
+  return {};
+}
+
+constexpr auto base64_size(std::size_t size, base64_alphabet alphabet) noexcept -> std::size_t
+{
+  if (alphabet == base64_alphabet::standard) return (size + 2) / 3 * 4;
+  return (size * 4 + 2) / 3;
+}
+
+inline auto base64_encode(std::string_view in, char* out, base64_alphabet alphabet) noexcept
+    -> char*
+{
+  const auto chars = base64_chars(alphabet);
+  const auto* bytes = as_bytes(in);
+  auto i = base64_encode_blocks(bytes, in.size(), out, chars[62], chars[63]);
+  out += i / 3 * 4;
+
+  for (; i + 3 <= in.size(); i += 3) {
+    const auto triple = (std::uint32_t{bytes[i]} << 16U) | (std::uint32_t{bytes[i + 1]} << 8U) |
+                        std::uint32_t{bytes[i + 2]};
+    *out++ = chars[(triple >> 18U) & 0x3fU];
+    *out++ = chars[(triple >> 12U) & 0x3fU];
+    *out++ = chars[(triple >> 6U) & 0x3fU];
+    *out++ = chars[triple & 0x3fU];
+  }
+
+  const auto rest = in.size() - i;
+  if (rest == 0) return out;
+
+  const auto triple = (std::uint32_t{bytes[i]} << 16U) |
+                      (rest == 2 ? std::uint32_t{bytes[i + 1]} << 8U : 0U);
+  *out++ = chars[(triple >> 18U) & 0x3fU];
+  *out++ = chars[(triple >> 12U) & 0x3fU];
+  if (rest == 2) *out++ = chars[(triple >> 6U) & 0x3fU];
+  if (alphabet == base64_alphabet::standard) {
+    *out++ = '=';
+    if (rest == 1) *out++ = '=';
+  }
+  return out;
+}
+
+/**
+ * @brief Strip the padding of an encoded string and check its length.
+ *
+ * Padding is optional, but if present it must complete the last block.
+ *
+ * @return result<std::string_view, std::errc> The characters without the padding.
+ */
+inline auto strip_padding(std::string_view in, std::size_t block, std::size_t max_padding) noexcept
+    -> result<std::string_view, std::errc>
+{
+  const auto padded = in.size();
+  std::size_t padding = 0;
+  while (!in.empty() && in.back() == '=' && padding < max_padding) {
+    in.remove_suffix(1);
+    ++padding;
+  }
+  if (padding != 0 && padded % block != 0) return std::errc::invalid_argument;
+  return in;
+}
+
+/**
+ * @brief Whether the `count` bits left over after the last decoded byte are not all zero.
+ *
+ * The encoders set them to zero, so every byte string has exactly one encoding, e.g. `Zg==` but not
+ * `Zh==`.
+ */
+constexpr auto has_trailing_bits(std::uint64_t bits, unsigned count) noexcept -> bool
+{
+  return (bits & ((std::uint64_t{1} << count) - 1U)) != 0;
+}
+
+inline auto base64_decoded_size(std::string_view in) noexcept -> result<std::size_t, std::errc>
+{
+  if (in.size() % 4 == 1) return std::errc::invalid_argument;
+  return in.size() / 4 * 3 + (in.size() % 4 == 0 ? 0 : in.size() % 4 - 1);
+}
+
+inline auto base64_decode(std::string_view in, char* out, base64_alphabet alphabet) noexcept
+    -> std::errc
+{
+  const auto& table = alphabet == base64_alphabet::url ? base64_url_decode_table
+                                                       : base64_standard_decode_table;
+  const auto chars = base64_chars(alphabet);
+  const auto i = base64_decode_blocks(in.data(), in.size(),
+                                      reinterpret_cast<unsigned char*>(out),  // NOLINT
+                                      chars[62], chars[63]);
+  out += i / 4 * 3;
+  in.remove_prefix(i);
+
+  std::uint32_t bits = 0;
+  unsigned count = 0;
+  for (const char c : in) {
+    const auto code = table[static_cast<unsigned char>(c)];
+    if (code == invalid_code) return std::errc::invalid_argument;
+    bits = (bits << 6U) | code;
+    count += 6;
+    if (count >= 8) {
+      count -= 8;
+      *out++ = static_cast<char>((bits >> count) & 0xffU);
+    }
+  }
+  return has_trailing_bits(bits, count) ? std::errc::invalid_argument : std::errc{};
+}
+
+constexpr auto base32_size(std::size_t size) noexcept -> std::size_t { return (size + 4) / 5 * 8; }
+
+inline auto base32_encode(std::string_view in, char* out) noexcept -> char*
+{
+  const auto* bytes = as_bytes(in);
+  std::uint64_t bits = 0;
+  unsigned count = 0;
+  char* const first = out;
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    bits = (bits << 8U) | bytes[i];
+    count += 8;
+    while (count >= 5) {
+      count -= 5;
+      *out++ = base32_chars[(bits >> count) & 0x1fU];
+    }
+  }
+  if (count > 0) *out++ = base32_chars[(bits << (5 - count)) & 0x1fU];
+  while (static_cast<std::size_t>(out - first) % 8 != 0) {
+    *out++ = '=';
+  }
+  return out;
+}
+
+inline auto base32_decoded_size(std::string_view in) noexcept -> result<std::size_t, std::errc>
+{
+  const auto rest = in.size() % 8;
+  if (rest == 1 || rest == 3 || rest == 6) return std::errc::invalid_argument;
+  return in.size() * 5 / 8;
+}
+
+inline auto base32_decode(std::string_view in, char* out) noexcept -> std::errc
+{
+  std::uint64_t bits = 0;
+  unsigned count = 0;
+  for (const char c : in) {
+    const auto code = base32_decode_table[static_cast<unsigned char>(c)];
+    if (code == invalid_code) return std::errc::invalid_argument;
+    bits = (bits << 5U) | code;
+    count += 5;
+    if (count >= 8) {
+      count -= 8;
+      *out++ = static_cast<char>((bits >> count) & 0xffU);
+    }
+  }
+  return has_trailing_bits(bits, count) ? std::errc::invalid_argument : std::errc{};
+}
+
+/**
+ * @brief Encode into a buffer after checking that it is large enough.
+ */
+template <typename Encode>
+auto encode_to(std::size_t size, char* first, char* last, Encode encode) noexcept
+    -> result<char*, std::errc>
+{
+  if (size > static_cast<std::size_t>(last - first)) return std::errc::value_too_large;
+  return encode(first);
+}
+
+/**
+ * @brief Append the encoding to a string.
+ */
+template <typename Encode>
+auto append_encoded(std::string& out, std::size_t size, Encode encode) -> std::size_t
+{
+  const auto old_size = out.size();
+  out.resize(old_size + size);
+  encode(out.data() + old_size);
+  return size;
+}
+
+/**
+ * @brief Decode into a buffer after checking that it is large enough.
+ */
+template <typename Decode>
+auto decode_to(const result<std::size_t, std::errc>& size, char* first, char* last,
+               Decode decode) noexcept -> result<char*, std::errc>
+{
+  if (size.is_error()) return size.unwrap_error();
+  const auto bytes = size.unwrap_or(0);
+  if (bytes > static_cast<std::size_t>(last - first)) return std::errc::value_too_large;
+  if (const auto ec = decode(first); ec != std::errc{}) return ec;
+  return first + bytes;
+}
+
+/**
+ * @brief Append the decoding to a string, leaving it unchanged on error.
+ */
+template <typename Decode>
+auto append_decoded(std::string& out, const result<std::size_t, std::errc>& size, Decode decode)
+    -> result<std::size_t, std::errc>
+{
+  if (size.is_error()) return size;
+  const auto old_size = out.size();
+  out.resize(old_size + size.unwrap_or(0));
+  if (const auto ec = decode(out.data() + old_size); ec != std::errc{}) {
+    out.resize(old_size);
+    return ec;
+  }
+  return size;
+}
+
+}  // namespace detail
+
+/**
+ * @brief The number of characters `to_hex` produces for `size` bytes.
+ */
+constexpr auto hex_encoded_size(std::size_t size) noexcept -> std::size_t { return 2 * size; }
+
+/**
+ * @brief The number of characters `base64_encode` produces for `size` bytes.
+ */
+constexpr auto base64_encoded_size(std::size_t size,
+                                   base64_alphabet alphabet = base64_alphabet::standard) noexcept
+    -> std::size_t
+{
+  return detail::base64_size(size, alphabet);
+}
+
+/**
+ * @brief The number of characters `base32_encode` produces for `size` bytes.
+ */
+constexpr auto base32_encoded_size(std::size_t size) noexcept -> std::size_t
+{
+  return detail::base32_size(size);
+}
+
+/**
+ * @brief Append the lowercase hexadecimal representation of some bytes to a string.
+ *
+ * The encoding is vectorized with SSSE3 or AVX2 if the CPU supports it.
+ *
+ * @param out The string to append to.
+ * @param bytes The bytes to encode.
+ * @return std::size_t The number of characters appended.
+ */
+inline auto append_hex(std::string& out, std::string_view bytes) -> std::size_t
+{
+  return detail::append_encoded(out, hex_encoded_size(bytes.size()),
+                                [bytes](char* first) { detail::hex_encode(bytes, first); });
+}
+
+/**
+ * @brief Encode some bytes as lowercase hexadecimal digits.
+ *
+ * Example:
+ * @snippet encoding_test.cpp to_hex-example
+ *
+ * @param bytes The bytes to encode.
+ * @return std::string Two digits per byte.
+ */
+inline auto to_hex(std::string_view bytes) -> std::string
+{
+  std::string out;
+  append_hex(out, bytes);
+  return out;
+}
+
+/**
+ * @brief Encode some bytes as lowercase hexadecimal digits into a buffer.
+ *
+ * @param bytes The bytes to encode.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @return result<char*, std::errc> One past the last written character, or
+ *         `std::errc::value_too_large` if the buffer is too small.
+ */
+inline auto to_hex(std::string_view bytes, char* first, char* last) noexcept
+    -> result<char*, std::errc>
+{
+  return detail::encode_to(hex_encoded_size(bytes.size()), first, last,
+                           [bytes](char* out) { return detail::hex_encode(bytes, out); });
+}
+
+/**
+ * @brief Decode hexadecimal digits and append the bytes to a string.
+ *
+ * Upper and lowercase digits are accepted. The string is left unchanged on error.
+ *
+ * @param out The string to append to.
+ * @param hex The digits to decode.
+ * @return result<std::size_t, std::errc> The number of bytes appended, or
+ *         `std::errc::invalid_argument` for an odd number of digits or a character that is not a
+ *         hexadecimal digit.
+ */
+inline auto append_from_hex(std::string& out, std::string_view hex)
+    -> result<std::size_t, std::errc>
+{
+  if (hex.size() % 2 != 0) return std::errc::invalid_argument;
+  return detail::append_decoded(out, hex.size() / 2,
+                                [hex](char* first) { return detail::hex_decode(hex, first); });
+}
+
+/**
+ * @brief Decode hexadecimal digits.
+ *
+ * Example:
+ * @snippet encoding_test.cpp to_hex-example
+ *
+ * @param hex The digits to decode, upper or lowercase.
+ * @return result<std::string, std::errc> The bytes, or `std::errc::invalid_argument` for an odd
+ *         number of digits or a character that is not a hexadecimal digit.
+ */
+inline auto from_hex(std::string_view hex) -> result<std::string, std::errc>
+{
+  std::string out;
+  return append_from_hex(out, hex).map([&out](std::size_t /* unused */) { return std::move(out); });
+}
+
+/**
+ * @brief Decode hexadecimal digits into a buffer.
+ *
+ * The contents of the buffer are unspecified on error.
+ *
+ * @param hex The digits to decode, upper or lowercase.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @return result<char*, std::errc> One past the last written byte, `std::errc::value_too_large` if
+ *         the buffer is too small, or `std::errc::invalid_argument` if the digits are invalid.
+ */
+inline auto from_hex(std::string_view hex, char* first, char* last) noexcept
+    -> result<char*, std::errc>
+{
+  const result<std::size_t, std::errc> size =
+      hex.size() % 2 == 0 ? result<std::size_t, std::errc>{hex.size() / 2}
+                          : result<std::size_t, std::errc>{std::errc::invalid_argument};
+  return detail::decode_to(size, first, last,
+                           [hex](char* out) { return detail::hex_decode(hex, out); });
+}
+
+/**
+ * @brief Append the base64 encoding of some bytes to a string.
+ *
+ * With the standard alphabet the output is padded with `=`, with the URL alphabet it is not.
+ *
+ * @param out The string to append to.
+ * @param bytes The bytes to encode.
+ * @param alphabet The alphabet to use.
+ * @return std::size_t The number of characters appended.
+ */
+inline auto append_base64_encode(std::string& out, std::string_view bytes,
+                                 base64_alphabet alphabet = base64_alphabet::standard)
+    -> std::size_t
+{
+  return detail::append_encoded(
+      out, base64_encoded_size(bytes.size(), alphabet),
+      [bytes, alphabet](char* first) { detail::base64_encode(bytes, first, alphabet); });
+}
+
+/**
+ * @brief Encode some bytes as base64.
+ *
+ * With the standard alphabet the output is padded with `=`, with the URL alphabet it is not. The
+ * encoding is vectorized with SSSE3 if the CPU supports it.
+ *
+ * Example:
+ * @snippet encoding_test.cpp base64-example
+ *
+ * @param bytes The bytes to encode.
+ * @param alphabet The alphabet to use.
+ * @return std::string The encoded characters.
+ */
+inline auto base64_encode(std::string_view bytes,
+                          base64_alphabet alphabet = base64_alphabet::standard) -> std::string
+{
+  std::string out;
+  append_base64_encode(out, bytes, alphabet);
+  return out;
+}
+
+/**
+ * @brief Encode some bytes as base64 into a buffer.
+ *
+ * @param bytes The bytes to encode.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @param alphabet The alphabet to use.
+ * @return result<char*, std::errc> One past the last written character, or
+ *         `std::errc::value_too_large` if the buffer is too small.
+ */
+inline auto base64_encode(std::string_view bytes, char* first, char* last,
+                          base64_alphabet alphabet = base64_alphabet::standard) noexcept
+    -> result<char*, std::errc>
+{
+  return detail::encode_to(
+      base64_encoded_size(bytes.size(), alphabet), first, last,
+      [bytes, alphabet](char* out) { return detail::base64_encode(bytes, out, alphabet); });
+}
+
+/**
+ * @brief Decode base64 and append the bytes to a string.
+ *
+ * Padding is optional for both alphabets. Decoding is strict: the unused bits of the last
+ * character must be zero, as the encoder writes them. The string is left unchanged on error.
+ *
+ * @param out The string to append to.
+ * @param encoded The characters to decode.
+ * @param alphabet The alphabet to use.
+ * @return result<std::size_t, std::errc> The number of bytes appended, or
+ *         `std::errc::invalid_argument` if the input is not valid base64.
+ */
+inline auto append_base64_decode(std::string& out, std::string_view encoded,
+                                 base64_alphabet alphabet = base64_alphabet::standard)
+    -> result<std::size_t, std::errc>
+{
+  return detail::strip_padding(encoded, 4, 2).and_then(
+      [&out, alphabet](std::string_view chars) {
+        return detail::append_decoded(out, detail::base64_decoded_size(chars),
+                                      [chars, alphabet](char* first) {
+                                        return detail::base64_decode(chars, first, alphabet);
+                                      });
+      });
+}
+
+/**
+ * @brief Decode base64.
+ *
+ * The decoding is vectorized with SSSE3 or AVX2 if the CPU supports it.
+ *
+ * Example:
+ * @snippet encoding_test.cpp base64-example
+ *
+ * @param encoded The characters to decode, padding is optional.
+ * @param alphabet The alphabet to use.
+ * @return result<std::string, std::errc> The bytes, or `std::errc::invalid_argument` if the input
+ *         is not valid base64.
+ */
+inline auto base64_decode(std::string_view encoded,
+                          base64_alphabet alphabet = base64_alphabet::standard)
+    -> result<std::string, std::errc>
+{
+  std::string out;
+  return append_base64_decode(out, encoded, alphabet).map([&out](std::size_t /* unused */) {
+    return std::move(out);
+  });
+}
+
+/**
+ * @brief Decode base64 into a buffer.
+ *
+ * The contents of the buffer are unspecified on error.
+ *
+ * @param encoded The characters to decode, padding is optional.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @param alphabet The alphabet to use.
+ * @return result<char*, std::errc> One past the last written byte, `std::errc::value_too_large` if
+ *         the buffer is too small, or `std::errc::invalid_argument` if the input is not valid.
+ */
+inline auto base64_decode(std::string_view encoded, char* first, char* last,
+                          base64_alphabet alphabet = base64_alphabet::standard) noexcept
+    -> result<char*, std::errc>
+{
+  return detail::strip_padding(encoded, 4, 2).and_then(
+      [first, last, alphabet](std::string_view chars) {
+        return detail::decode_to(detail::base64_decoded_size(chars), first, last,
+                                 [chars, alphabet](char* out) {
+                                   return detail::base64_decode(chars, out, alphabet);
+                                 });
+      });
+}
+
+/**
+ * @brief Append the padded base32 encoding (RFC 4648) of some bytes to a string.
+ *
+ * @param out The string to append to.
+ * @param bytes The bytes to encode.
+ * @return std::size_t The number of characters appended.
+ */
+inline auto append_base32_encode(std::string& out, std::string_view bytes) -> std::size_t
+{
+  return detail::append_encoded(out, base32_encoded_size(bytes.size()),
+                                [bytes](char* first) { detail::base32_encode(bytes, first); });
+}
+
+/**
+ * @brief Encode some bytes as padded base32 (RFC 4648).
+ *
+ * Example:
+ * @snippet encoding_test.cpp base32-example
+ *
+ * @param bytes The bytes to encode.
+ * @return std::string The encoded characters.
+ */
+inline auto base32_encode(std::string_view bytes) -> std::string
+{
+  std::string out;
+  append_base32_encode(out, bytes);
+  return out;
+}
+
+/**
+ * @brief Encode some bytes as padded base32 into a buffer.
+ *
+ * @param bytes The bytes to encode.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @return result<char*, std::errc> One past the last written character, or
+ *         `std::errc::value_too_large` if the buffer is too small.
+ */
+inline auto base32_encode(std::string_view bytes, char* first, char* last) noexcept
+    -> result<char*, std::errc>
+{
+  return detail::encode_to(base32_encoded_size(bytes.size()), first, last,
+                           [bytes](char* out) { return detail::base32_encode(bytes, out); });
+}
+
+/**
+ * @brief Decode base32 and append the bytes to a string.
+ *
+ * Padding is optional. Decoding is strict: the unused bits of the last character must be zero,
+ * as the encoder writes them. The string is left unchanged on error.
+ *
+ * @param out The string to append to.
+ * @param encoded The characters to decode.
+ * @return result<std::size_t, std::errc> The number of bytes appended, or
+ *         `std::errc::invalid_argument` if the input is not valid base32.
+ */
+inline auto append_base32_decode(std::string& out, std::string_view encoded)
+    -> result<std::size_t, std::errc>
+{
+  return detail::strip_padding(encoded, 8, 6).and_then([&out](std::string_view chars) {
+    return detail::append_decoded(out, detail::base32_decoded_size(chars), [chars](char* first) {
+      return detail::base32_decode(chars, first);
+    });
+  });
+}
+
+/**
+ * @brief Decode base32.
+ *
+ * Example:
+ * @snippet encoding_test.cpp base32-example
+ *
+ * @param encoded The characters to decode, padding is optional.
+ * @return result<std::string, std::errc> The bytes, or `std::errc::invalid_argument` if the input
+ *         is not valid base32.
+ */
+inline auto base32_decode(std::string_view encoded) -> result<std::string, std::errc>
+{
+  std::string out;
+  return append_base32_decode(out, encoded).map([&out](std::size_t /* unused */) {
+    return std::move(out);
+  });
+}
+
+/**
+ * @brief Decode base32 into a buffer.
+ *
+ * The contents of the buffer are unspecified on error.
+ *
+ * @param encoded The characters to decode, padding is optional.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @return result<char*, std::errc> One past the last written byte, `std::errc::value_too_large` if
+ *         the buffer is too small, or `std::errc::invalid_argument` if the input is not valid.
+ */
+inline auto base32_decode(std::string_view encoded, char* first, char* last) noexcept
+    -> result<char*, std::errc>
+{
+  return detail::strip_padding(encoded, 8, 6).and_then([first, last](std::string_view chars) {
+    return detail::decode_to(detail::base32_decoded_size(chars), first, last,
+                             [chars](char* out) { return detail::base32_decode(chars, out); });
+  });
+}
+
+}  // namespace bricks
@@ -0,0 +1,258 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "result.hpp"
+
+namespace bricks {
+
+/**
+ * @brief A name of an enumerator.
+ */
+template <typename E>
+struct enum_entry {
+  /** @brief The enumerator. */
+  E value;
+  /** @brief Its name. */
+  std::string_view name;
+};
+
+/**
+ * @brief Declares the names of the enumerators of `E`.
+ *
+ * Specialize it with a `static constexpr` array of `enum_entry<E>` named `entries` to enable
+ * `enum_to_string`, `enum_from_string` and the enum support of `to_string` and `from_string`.
+ *
+ * Example:
+ * @snippet enum_test.cpp enum_traits-declaration
+ */
+template <typename E>
+struct enum_traits;
+
+namespace detail {
+
+template <typename E, typename = void>
+struct has_enum_traits : std::false_type {
+};
+
+template <typename E>
+struct has_enum_traits<E, std::void_t<decltype(enum_traits<E>::entries)>> : std::true_type {
+};
+
+}  // namespace detail
+
+/**
+ * @brief Check whether `enum_traits<E>` declares the names of `E`.
+ */
+template <typename E>
+inline constexpr bool has_enum_traits_v = detail::has_enum_traits<E>::value;
+
+namespace detail {
+
+constexpr auto enum_name_hash(std::string_view name, std::uint64_t seed) noexcept -> std::uint64_t
+{
+  std::uint64_t hash = 14695981039346656037ULL ^ (seed * 0x9E3779B97F4A7C15ULL);
+  for (const char c : name) {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ULL;
+  }
+  return hash ^ (hash >> 32U);
+}
+
+template <typename E>
+constexpr auto enum_size() noexcept -> std::size_t
+{
+  return enum_traits<E>::entries.size();
+}
+
+template <typename E>
+constexpr auto has_unique_names() noexcept -> bool
+{
+  constexpr auto& entries = enum_traits<E>::entries;
+  for (std::size_t i = 0; i < entries.size(); ++i) {
+    for (std::size_t j = i + 1; j < entries.size(); ++j) {
+      if (entries[i].name == entries[j].name) return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief A perfect hash of the names of `E` into `Size` slots.
+ *
+ * `slots[hash(name, seed) % Size]` holds the index of the entry with that name plus one, zero for
+ * unused slots. So a lookup is a single hash and a single string comparison.
+ */
+template <std::size_t Size>
+struct enum_name_table {
+  std::uint64_t seed{0};
+  bool found{false};
+  std::array<std::uint16_t, Size> slots{};
+};
+
+constexpr std::uint64_t max_enum_seeds = 256;
+
+template <typename E, std::size_t Size>
+constexpr auto try_enum_name_table() noexcept -> enum_name_table<Size>
+{
+  constexpr auto& entries = enum_traits<E>::entries;
+  enum_name_table<Size> table{};
+  for (std::uint64_t seed = 0; seed < max_enum_seeds; ++seed) {
+    table.slots = {};
+    table.seed = seed;
+    table.found = true;
+    for (std::size_t i = 0; i < entries.size() && table.found; ++i) {
+      auto& slot = table.slots[enum_name_hash(entries[i].name, seed) % Size];
+      table.found = slot == 0;
+      slot = static_cast<std::uint16_t>(i + 1);
+    }
+    if (table.found) return table;
+  }
+  return table;
+}
+
+constexpr auto next_power_of_two(std::size_t value) noexcept -> std::size_t
+{
+  std::size_t power = 1;
+  while (power < value) {
+    power *= 2;
+  }
+  return power;
+}
+
+/**
+ * @brief Search seeds for a collision free table, doubling the table size if none is found.
+ */
+template <typename E, std::size_t Size = next_power_of_two(2 * enum_size<E>())>
+constexpr auto make_enum_name_table() noexcept
+{
+  static_assert(Size <= (std::size_t{1} << 16U), "Could not find a perfect hash for the names.");
+  constexpr auto table = try_enum_name_table<E, Size>();
+  if constexpr (table.found) {
+    return table;
+  } else {
+    return make_enum_name_table<E, 2 * Size>();
+  }
+}
+
+template <typename E>
+inline constexpr auto enum_name_table_v = make_enum_name_table<E>();
+
+/**
+ * @brief The names indexed by `value - min` if the values are contiguous.
+ */
+template <typename E>
+struct enum_value_table {
+  using underlying = std::underlying_type_t<E>;
+
+  underlying min{0};
+  bool dense{false};
+  std::array<std::string_view, enum_traits<E>::entries.size()> names{};
+};
+
+template <typename E>
+constexpr auto make_enum_value_table() noexcept -> enum_value_table<E>
+{
+  using underlying = std::underlying_type_t<E>;
+  constexpr auto& entries = enum_traits<E>::entries;
+
+  enum_value_table<E> table{};
+  if (entries.size() == 0) return table;
+
+  auto min = static_cast<underlying>(entries[0].value);
+  auto max = min;
+  for (const auto& entry : entries) {
+    const auto value = static_cast<underlying>(entry.value);
+    min = value < min ? value : min;
+    max = value > max ? value : max;
+  }
+  table.min = min;
+  // Compared in the unsigned domain so that the span of wide types cannot overflow.
+  using span_t = std::make_unsigned_t<underlying>;
+  if (static_cast<span_t>(static_cast<span_t>(max) - static_cast<span_t>(min)) !=
+      entries.size() - 1) {
+    return table;
+  }
+
+  table.dense = true;
+  for (const auto& entry : entries) {
+    auto& name = table.names[static_cast<std::size_t>(
+        static_cast<span_t>(static_cast<underlying>(entry.value)) - static_cast<span_t>(min))];
+    // An alias leaves a gap elsewhere in the range, so fall back to the linear search.
+    if (!name.empty()) table.dense = false;
+    name = entry.name;
+  }
+  return table;
+}
+
+template <typename E>
+inline constexpr auto enum_value_table_v = make_enum_value_table<E>();
+
+}  // namespace detail
+
+/**
+ * @brief Convert an enumerator to its name.
+ *
+ * Contiguous enumerations are looked up by index, others by a linear search of the table.
+ *
+ * Example:
+ * @snippet enum_test.cpp enum_traits-example
+ *
+ * @tparam E The enumeration, must specialize `enum_traits`.
+ * @param value The enumerator to convert.
+ * @return result<std::string_view, std::errc> The name, or `std::errc::invalid_argument` if `value`
+ *         has no name.
+ */
+template <typename E>
+constexpr auto enum_to_string(E value) noexcept -> result<std::string_view, std::errc>
+{
+  static_assert(has_enum_traits_v<E>, "Specialize bricks::enum_traits for this enumeration.");
+  using underlying = std::underlying_type_t<E>;
+  using span_t = std::make_unsigned_t<underlying>;
+  constexpr auto& table = detail::enum_value_table_v<E>;
+
+  if constexpr (table.dense) {
+    const auto offset = static_cast<span_t>(static_cast<span_t>(static_cast<underlying>(value)) -
+                                            static_cast<span_t>(table.min));
+    if (offset < table.names.size()) return table.names[offset];
+  } else {
+    for (const auto& entry : enum_traits<E>::entries) {
+      if (entry.value == value) return entry.name;
+    }
+  }
+  return std::errc::invalid_argument;
+}
+
+/**
+ * @brief Convert a name to its enumerator.
+ *
+ * The names are placed into a table by a perfect hash found at compile time, so parsing costs a
+ * single hash and a single string comparison, regardless of the number of enumerators.
+ *
+ * Example:
+ * @snippet enum_test.cpp enum_traits-example
+ *
+ * @tparam E The enumeration, must specialize `enum_traits`.
+ * @param name The name to convert, compared case-sensitively.
+ * @return result<E, std::errc> The enumerator, or `std::errc::invalid_argument` for an unknown
+ *         name.
+ */
+template <typename E>
+constexpr auto enum_from_string(std::string_view name) noexcept -> result<E, std::errc>
+{
+  static_assert(has_enum_traits_v<E>, "Specialize bricks::enum_traits for this enumeration.");
+  static_assert(detail::has_unique_names<E>(), "The names of the enumerators must be unique.");
+  constexpr auto& entries = enum_traits<E>::entries;
+  constexpr auto& table = detail::enum_name_table_v<E>;
+
+  const auto slot = table.slots[detail::enum_name_hash(name, table.seed) % table.slots.size()];
+  if (slot != 0 && entries[slot - 1].name == name) return entries[slot - 1].value;
+  return std::errc::invalid_argument;
+}
+
+}  // namespace bricks
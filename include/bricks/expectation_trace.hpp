@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+namespace bricks {
+
+/**
+ * @brief The location of a call in the source code, like the C++20 `std::source_location`.
+ *
+ * Captured as a default argument with `source_location::current()`, which evaluates to the
+ * location of the caller. Only pointers to string literals are stored, so it never allocates.
+ */
+class source_location {
+ public:
+  /**
+   * @brief The location of the call, or of the caller if used as a default argument.
+   */
+  [[nodiscard]] static constexpr auto current(const char* file = __builtin_FILE(),
+                                              const char* function = __builtin_FUNCTION(),
+                                              std::uint_least32_t line = __builtin_LINE()) noexcept
+      -> source_location
+  {
+    return source_location{file, function, line};
+  }
+
+  constexpr source_location() noexcept = default;
+
+  /** @brief The name of the source file. */
+  [[nodiscard]] constexpr auto file_name() const noexcept -> const char* { return file_; }
+  /** @brief The name of the enclosing function. */
+  [[nodiscard]] constexpr auto function_name() const noexcept -> const char* { return function_; }
+  /** @brief The line number. */
+  [[nodiscard]] constexpr auto line() const noexcept -> std::uint_least32_t { return line_; }
+
+ private:
+  constexpr source_location(const char* file, const char* function,
+                            std::uint_least32_t line) noexcept
+      : file_(file), function_(function), line_(line)
+  {
+  }
+
+  const char* file_{""};
+  const char* function_{""};
+  std::uint_least32_t line_{0};
+};
+
+/**
+ * @brief A failed expectation, i.e. a call of `expect`, `unwrap` or their `_error` variants on a
+ *        result holding the other alternative.
+ */
+class failed_expectation {
+ public:
+  /** @brief Messages are truncated to this many characters. */
+  static constexpr std::size_t max_message_size = 95;
+
+  constexpr failed_expectation() noexcept = default;
+
+  failed_expectation(source_location location, std::string_view message,
+                     std::uint64_t sequence) noexcept
+      : location_(location), sequence_(sequence)
+  {
+    size_ = std::min(message.size(), max_message_size);
+    if (size_ != 0) std::memcpy(message_.data(), message.data(), size_);
+  }
+
+  /** @brief Where the expectation failed. */
+  [[nodiscard]] constexpr auto location() const noexcept -> source_location { return location_; }
+  /** @brief The message, possibly truncated. */
+  [[nodiscard]] auto message() const noexcept -> std::string_view
+  {
+    return {message_.data(), size_};
+  }
+  /** @brief The number of expectations that failed before this one. */
+  [[nodiscard]] constexpr auto sequence() const noexcept -> std::uint64_t { return sequence_; }
+
+ private:
+  source_location location_{};
+  std::uint64_t sequence_{0};
+  std::size_t size_{0};
+  std::array<char, max_message_size> message_{};
+};
+
+/**
+ * @brief A fixed size ring of the most recent failed expectations.
+ *
+ * Recording copies the location and the truncated message into a preallocated slot, so it neither
+ * allocates nor blocks other threads, except for a brief spin if two threads write the same slot.
+ * `result` records into the global trace before throwing `bad_result_access`, so the trace
+ * shows where expectations failed even if the exceptions were caught and discarded.
+ *
+ * Example:
+ * @snippet expectation_trace_test.cpp expectation_trace-example
+ */
+class expectation_trace {
+ public:
+  /** @brief The number of expectations kept. */
+  static constexpr std::size_t capacity = 32;
+
+  /**
+   * @brief The trace `result` records into.
+   */
+  [[nodiscard]] static auto global() noexcept -> expectation_trace&
+  {
+    static expectation_trace trace;
+    return trace;
+  }
+
+  /**
+   * @brief Record a failed expectation, overwriting the oldest one if the ring is full.
+   *
+   * @param location Where the expectation failed.
+   * @param message The message, truncated to `failed_expectation::max_message_size` characters.
+   */
+  void record(source_location location, std::string_view message) noexcept
+  {
+    const auto sequence = next_.fetch_add(1, std::memory_order_relaxed);
+    auto& slot = slots_[sequence % capacity];
+    while (slot.busy.exchange(true, std::memory_order_acquire)) {
+    }
+    // A thread that drew the same slot `capacity` failures later may have been faster.
+    if (!slot.used || slot.entry.sequence() < sequence) {
+      slot.entry = failed_expectation{location, message, sequence};
+      slot.used = true;
+    }
+    slot.busy.store(false, std::memory_order_release);
+  }
+
+  /**
+   * @brief The number of expectations recorded since construction or the last `clear`.
+   */
+  [[nodiscard]] auto size() const noexcept -> std::uint64_t
+  {
+    return next_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Copy the kept expectations.
+   *
+   * @return std::vector<failed_expectation> The at most `capacity` most recent expectations, the
+   *         oldest first.
+   */
+  [[nodiscard]] auto recent() const -> std::vector<failed_expectation>
+  {
+    std::vector<failed_expectation> entries;
+    entries.reserve(capacity);
+    for (auto& slot : slots_) {
+      while (slot.busy.exchange(true, std::memory_order_acquire)) {
+      }
+      if (slot.used) entries.push_back(slot.entry);
+      slot.busy.store(false, std::memory_order_release);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.sequence() < rhs.sequence();
+    });
+    return entries;
+  }
+
+  /**
+   * @brief Forget all recorded expectations.
+   */
+  void clear() noexcept
+  {
+    for (auto& slot : slots_) {
+      while (slot.busy.exchange(true, std::memory_order_acquire)) {
+      }
+      slot.used = false;
+      slot.busy.store(false, std::memory_order_release);
+    }
+    next_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  struct slot {
+    mutable std::atomic<bool> busy{false};
+    bool used{false};
+    failed_expectation entry{};
+  };
+
+  std::atomic<std::uint64_t> next_{0};
+  std::array<slot, capacity> slots_{};
+};
+
+}  // namespace bricks
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+#include "detail/digits.hpp"
+#include "detail/swar.hpp"
+#include "result.hpp"
+
+namespace bricks {
+
+namespace detail {
+
+constexpr auto make_powers_of_ten() noexcept -> std::array<std::uint64_t, 20>
+{
+  std::array<std::uint64_t, 20> powers{};
+  powers[0] = 1;
+  for (std::size_t i = 1; i < powers.size(); ++i) {
+    powers[i] = powers[i - 1] * 10U;
+  }
+  return powers;
+}
+
+inline constexpr auto powers_of_ten = make_powers_of_ten();
+
+/**
+ * @brief `acc = acc * factor + addend`, unless the result would exceed `limit`.
+ *
+ * @return true If `acc` was updated.
+ */
+constexpr auto checked_mul_add(std::uint64_t& acc, std::uint64_t factor, std::uint64_t addend,
+                               std::uint64_t limit) noexcept -> bool
+{
+  if (addend > limit || acc > (limit - addend) / factor) return false;
+  acc = acc * factor + addend;
+  return true;
+}
+
+constexpr auto is_digit(char c) noexcept -> bool { return c >= '0' && c <= '9'; }
+
+/**
+ * @brief Accumulate up to `max_digits` digits starting at `pos`, eight at a time where possible.
+ *
+ * @return std::errc `result_out_of_range` if the value exceeds `limit`, success otherwise.
+ */
+inline auto accumulate_digits(std::string_view str, std::size_t& pos, std::size_t max_digits,
+                              std::uint64_t& acc, std::uint64_t limit) noexcept -> std::errc
+{
+  const auto end = pos + std::min(max_digits, str.size() - pos);
+  while (end - pos >= 8) {
+    const auto word = load_eight_chars(str.data() + pos);
+    if (!is_eight_digits(word)) break;
+    if (!checked_mul_add(acc, powers_of_ten[8], parse_eight_digits(word), limit)) {
+      return std::errc::result_out_of_range;
+    }
+    pos += 8;
+  }
+  while (pos < end && is_digit(str[pos])) {
+    if (!checked_mul_add(acc, 10U, static_cast<std::uint64_t>(str[pos] - '0'), limit)) {
+      return std::errc::result_out_of_range;
+    }
+    ++pos;
+  }
+  return {};
+}
+
+}  // namespace detail
+
+/**
+ * @brief Exceptionlessly parse a decimal number as a fixed-point integer with `Scale` fractional
+ * digits.
+ *
+ * `"1234.5678"` parses to `12345678` with a scale of 4. The number is parsed exactly, without going
+ * through floating point. Digits are converted eight at a time.
+ *
+ * The accepted format is an optional `-`, at least one digit, and optionally a `.` followed by at
+ * least one digit. Fractional digits beyond the scale are accepted only if they are zeros, since
+ * anything else could not be represented.
+ *
+ * Example:
+ * @snippet fixed_point_test.cpp from_string_fixed-example
+ *
+ * @tparam Scale The number of fractional digits.
+ * @param str The string to parse.
+ * @return result<std::int64_t, std::errc> The scaled value, `std::errc::invalid_argument` if the
+ *         string is not a number or has too many significant fractional digits, or
+ *         `std::errc::result_out_of_range` if the scaled value does not fit into an `int64_t`.
+ */
+template <unsigned Scale>
+auto from_string_fixed(std::string_view str) noexcept -> result<std::int64_t, std::errc>
+{
+  static_assert(Scale <= 18, "The scale must be at most 18 digits.");
+
+  std::size_t pos = 0;
+  const bool negative = !str.empty() && str[0] == '-';
+  if (negative) ++pos;
+
+  // The magnitude of the minimum is one larger than the maximum.
+  const auto limit =
+      static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()) + (negative ? 1U : 0U);
+
+  std::uint64_t acc = 0;
+  const auto int_start = pos;
+  if (auto ec = detail::accumulate_digits(str, pos, str.size(), acc, limit); ec != std::errc{}) {
+    return ec;
+  }
+  if (pos == int_start) return std::errc::invalid_argument;
+
+  std::size_t fraction_digits = 0;
+  if (pos < str.size() && str[pos] == '.') {
+    const auto fraction_start = ++pos;
+    if (auto ec = detail::accumulate_digits(str, pos, Scale, acc, limit); ec != std::errc{}) {
+      return ec;
+    }
+    fraction_digits = pos - fraction_start;
+
+    while (pos < str.size() && str[pos] == '0') {
+      ++pos;
+    }
+    if (pos == fraction_start) return std::errc::invalid_argument;
+  }
+  if (pos != str.size()) return std::errc::invalid_argument;
+
+  if (!detail::checked_mul_add(acc, detail::powers_of_ten[Scale - fraction_digits], 0, limit)) {
+    return std::errc::result_out_of_range;
+  }
+
+  return negative ? static_cast<std::int64_t>(0U - acc) : static_cast<std::int64_t>(acc);
+}
+
+/**
+ * @brief Format a fixed-point integer with `Scale` fractional digits as a decimal number.
+ *
+ * Always writes exactly `Scale` fractional digits, so `12345678` with a scale of 4 becomes
+ * `"1234.5678"` and `-100` becomes `"-0.0100"`. The output can be parsed back by
+ * `from_string_fixed` with the same scale.
+ *
+ * Example:
+ * @snippet fixed_point_test.cpp to_string_fixed-example
+ *
+ * @tparam Scale The number of fractional digits.
+ * @param value The scaled value.
+ * @return std::string The decimal representation.
+ */
+template <unsigned Scale>
+auto to_string_fixed(std::int64_t value) -> std::string
+{
+  static_assert(Scale <= 18, "The scale must be at most 18 digits.");
+
+  // Sign, 19 digits, decimal point and the leading zero of a pure fraction.
+  std::array<char, 22> buffer{};
+  char* last = buffer.data() + buffer.size();
+  char* first = last;
+
+  const auto magnitude = detail::unsigned_magnitude(value);
+  const auto integral = magnitude / detail::powers_of_ten[Scale];
+  if constexpr (Scale > 0) {
+    const auto fraction = magnitude % detail::powers_of_ten[Scale];
+    first -= Scale;
+    const auto digits = detail::count_digits(fraction);
+    for (std::size_t i = 0; i < Scale - digits; ++i) {
+      first[i] = '0';
+    }
+    detail::write_digits_backwards(last, fraction);
+    *--first = '.';
+  }
+
+  const auto integral_digits = detail::count_digits(integral);
+  detail::write_digits_backwards(first, integral);
+  first -= integral_digits;
+  if (value < 0) *--first = '-';
+
+  return std::string(first, last);
+}
+
+}  // namespace bricks
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+namespace bricks {
+
+/**
+ * @brief A string with inline storage for up to `N` characters.
+ *
+ * The characters are stored in the object itself, followed by a null terminator, so creating,
+ * copying and returning a `fixed_string` never allocates. All operations are `constexpr`. It
+ * converts implicitly to `std::string_view`.
+ *
+ * Example:
+ * @snippet fixed_string_test.cpp fixed_string-example
+ *
+ * @tparam N The maximum number of characters.
+ */
+template <std::size_t N>
+class fixed_string {
+ public:
+  using value_type = char;
+  using size_type = std::size_t;
+  using iterator = char*;
+  using const_iterator = const char*;
+
+  /** @brief Construct an empty string. */
+  constexpr fixed_string() noexcept = default;
+
+  /**
+   * @brief Construct from a string literal that fits into the capacity.
+   */
+  template <std::size_t M>
+  // cppcheck-suppress noExplicitConstructor
+  constexpr fixed_string(const char (&str)[M]) noexcept  // NOLINT
+  {
+    static_assert(M - 1 <= N, "The string literal does not fit into the fixed_string.");
+    for (std::size_t i = 0; i + 1 < M; ++i) {
+      data_[i] = str[i];
+    }
+    size_ = M - 1;
+  }
+
+  /**
+   * @brief Construct from a string view.
+   *
+   * Throws `std::length_error` if the string does not fit, which makes it a compile time error in
+   * constant expressions.
+   */
+  constexpr explicit fixed_string(std::string_view str) : size_(str.size())
+  {
+    if (str.size() > N) throw std::length_error{"string does not fit into the fixed_string"};
+    for (std::size_t i = 0; i < str.size(); ++i) {
+      data_[i] = str[i];
+    }
+  }
+
+  /** @brief The characters, null terminated. */
+  [[nodiscard]] constexpr auto data() noexcept -> char* { return data_.data(); }
+  /** @brief The characters, null terminated. */
+  [[nodiscard]] constexpr auto data() const noexcept -> const char* { return data_.data(); }
+  /** @brief The characters, null terminated. */
+  [[nodiscard]] constexpr auto c_str() const noexcept -> const char* { return data_.data(); }
+
+  /** @brief The number of characters. */
+  [[nodiscard]] constexpr auto size() const noexcept -> size_type { return size_; }
+  /** @brief The number of characters. */
+  [[nodiscard]] constexpr auto length() const noexcept -> size_type { return size_; }
+  /** @brief Whether the string is empty. */
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool { return size_ == 0; }
+  /** @brief The maximum number of characters. */
+  [[nodiscard]] static constexpr auto capacity() noexcept -> size_type { return N; }
+
+  /**
+   * @brief Change the number of characters.
+   *
+   * Characters are not initialized when growing, which allows writing into `data()` first and
+   * setting the size afterwards. Throws `std::length_error` if `count` exceeds the capacity.
+   */
+  constexpr auto resize(size_type count) -> void
+  {
+    if (count > N) throw std::length_error{"fixed_string capacity exceeded"};
+    size_ = count;
+    data_[size_] = '\0';
+  }
+
+  [[nodiscard]] constexpr auto begin() noexcept -> iterator { return data_.data(); }
+  [[nodiscard]] constexpr auto begin() const noexcept -> const_iterator { return data_.data(); }
+  [[nodiscard]] constexpr auto end() noexcept -> iterator { return data_.data() + size_; }
+  [[nodiscard]] constexpr auto end() const noexcept -> const_iterator
+  {
+    return data_.data() + size_;
+  }
+
+  [[nodiscard]] constexpr auto operator[](size_type pos) noexcept -> char& { return data_[pos]; }
+  [[nodiscard]] constexpr auto operator[](size_type pos) const noexcept -> const char&
+  {
+    return data_[pos];
+  }
+
+  /** @brief View the characters. */
+  // cppcheck-suppress noExplicitConstructor
+  [[nodiscard]] constexpr operator std::string_view() const noexcept  // NOLINT
+  {
+    return {data_.data(), size_};
+  }
+
+  [[nodiscard]] friend constexpr auto operator==(const fixed_string& lhs,
+                                                 std::string_view rhs) noexcept -> bool
+  {
+    return std::string_view{lhs} == rhs;
+  }
+  [[nodiscard]] friend constexpr auto operator==(std::string_view lhs,
+                                                 const fixed_string& rhs) noexcept -> bool
+  {
+    return lhs == std::string_view{rhs};
+  }
+  [[nodiscard]] friend constexpr auto operator!=(const fixed_string& lhs,
+                                                 std::string_view rhs) noexcept -> bool
+  {
+    return !(lhs == rhs);
+  }
+  [[nodiscard]] friend constexpr auto operator!=(std::string_view lhs,
+                                                 const fixed_string& rhs) noexcept -> bool
+  {
+    return !(lhs == rhs);
+  }
+
+ private:
+  std::array<char, N + 1> data_{};
+  size_type size_{0};
+};
+
+template <std::size_t N, std::size_t M>
+[[nodiscard]] constexpr auto operator==(const fixed_string<N>& lhs,
+                                        const fixed_string<M>& rhs) noexcept -> bool
+{
+  return std::string_view{lhs} == std::string_view{rhs};
+}
+
+template <std::size_t N, std::size_t M>
+[[nodiscard]] constexpr auto operator!=(const fixed_string<N>& lhs,
+                                        const fixed_string<M>& rhs) noexcept -> bool
+{
+  return !(lhs == rhs);
+}
+
+/** @brief Deduce the capacity from a string literal. */
+template <std::size_t M>
+fixed_string(const char (&)[M]) -> fixed_string<M - 1>;
+
+}  // namespace bricks
@@ -0,0 +1,437 @@
+#pragma once
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "detail/digits.hpp"
+#include "result.hpp"
+
+/**
+ * @brief Wrap a string literal so `format_to` can parse it at compile time.
+ *
+ * Example:
+ * @snippet format_test.cpp format_to-example
+ */
+#define BRICKS_FORMAT_STRING(str)                                   \
+  [] {                                                              \
+    struct bricks_format_string : ::bricks::detail::format_string { \
+      constexpr operator std::string_view() const { return str; }   \
+    };                                                              \
+    return bricks_format_string{};                                  \
+  }()
+
+namespace bricks {
+
+namespace detail {
+
+/**
+ * @brief Base of the types created by `BRICKS_FORMAT_STRING`.
+ */
+struct format_string {
+};
+
+struct format_info {
+  std::size_t placeholders;
+  std::size_t literal_size;
+  bool valid;
+};
+
+constexpr auto scan_format(std::string_view fmt) noexcept -> format_info
+{
+  format_info info{0, 0, true};
+  for (std::size_t i = 0; i < fmt.size(); ++i) {
+    const auto next = i + 1 < fmt.size() ? fmt[i + 1] : '\0';
+    if (fmt[i] == '{' && next == '}') {
+      ++info.placeholders;
+      ++i;
+    } else if ((fmt[i] == '{' || fmt[i] == '}') && next == fmt[i]) {
+      ++info.literal_size;
+      ++i;
+    } else if (fmt[i] == '{' || fmt[i] == '}') {
+      info.valid = false;
+    } else {
+      ++info.literal_size;
+    }
+  }
+  return info;
+}
+
+/**
+ * @brief A format string split into its unescaped literal pieces.
+ *
+ * Piece `i` is `chars[offsets[i], offsets[i + 1])`, the `i`-th argument goes after it.
+ */
+template <std::size_t LiteralSize, std::size_t Placeholders>
+struct compiled_format {
+  std::array<char, LiteralSize> chars{};
+  std::array<std::size_t, Placeholders + 2> offsets{};
+};
+
+template <typename S>
+constexpr auto compile_format() noexcept
+{
+  constexpr std::string_view fmt = S{};
+  constexpr auto info = scan_format(fmt);
+  static_assert(info.valid, "Invalid format string: unmatched '{' or '}'. Use '{{' and '}}'.");
+
+  compiled_format<info.literal_size, info.placeholders> compiled{};
+  if (!info.valid) return compiled;
+
+  std::size_t size = 0;
+  std::size_t piece = 0;
+  for (std::size_t i = 0; i < fmt.size(); ++i) {
+    if (fmt[i] == '{' && fmt[i + 1] == '}') {
+      compiled.offsets[++piece] = size;
+      ++i;
+      continue;
+    }
+    if (fmt[i] == '{' || fmt[i] == '}') ++i;
+    compiled.chars[size++] = fmt[i];
+  }
+  compiled.offsets[piece + 1] = size;
+  return compiled;
+}
+
+template <typename S>
+inline constexpr auto compiled_format_v = compile_format<S>();
+
+/**
+ * @brief An integer argument, sized by counting its digits.
+ */
+template <typename Int>
+class integer_arg {
+ public:
+  constexpr explicit integer_arg(Int value) noexcept : value_(value) {}
+
+  [[nodiscard]] constexpr auto ok() const noexcept -> std::errc { return {}; }
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return integer_size(value_); }
+  constexpr auto write(char* first) const noexcept -> char* { return write_integer(first, value_); }
+
+ private:
+  Int value_;
+};
+
+/**
+ * @brief A floating point argument, converted once with `std::to_chars` while sizing.
+ */
+class floating_arg {
+ public:
+  template <typename Float>
+  explicit floating_arg(Float value) noexcept
+  {
+    const auto [ptr, ec] = std::to_chars(chars_.data(), chars_.data() + chars_.size(), value);
+    ec_ = ec;
+    size_ = ec == std::errc{} ? static_cast<std::size_t>(ptr - chars_.data()) : 0;
+  }
+
+  [[nodiscard]] auto ok() const noexcept -> std::errc { return ec_; }
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return size_; }
+  auto write(char* first) const noexcept -> char*
+  {
+    std::memcpy(first, chars_.data(), size_);
+    return first + size_;
+  }
+
+ private:
+  std::array<char, 64> chars_{};
+  std::size_t size_{0};
+  std::errc ec_{};
+};
+
+/**
+ * @brief A textual argument, copied verbatim.
+ */
+class string_arg {
+ public:
+  constexpr explicit string_arg(std::string_view value) noexcept : value_(value) {}
+
+  [[nodiscard]] constexpr auto ok() const noexcept -> std::errc { return {}; }
+  [[nodiscard]] constexpr auto size() const noexcept -> std::size_t { return value_.size(); }
+  auto write(char* first) const noexcept -> char*
+  {
+    if (!value_.empty()) std::memcpy(first, value_.data(), value_.size());
+    return first + value_.size();
+  }
+
+ private:
+  std::string_view value_;
+};
+
+template <typename T>
+auto make_format_arg(const T& value) noexcept
+{
+  using type = std::decay_t<T>;
+  if constexpr (std::is_same_v<type, bool>) {
+    return string_arg{value ? "true" : "false"};
+  } else if constexpr (std::is_same_v<type, char>) {
+    return string_arg{std::string_view{&value, 1}};
+  } else if constexpr (std::is_integral_v<type>) {
+    return integer_arg<type>{value};
+  } else if constexpr (std::is_floating_point_v<type>) {
+    return floating_arg{value};
+  } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+    return string_arg{value};
+  } else {
+    static_assert(always_false_v<T>, "Unsupported argument type for format_to.");
+  }
+}
+
+template <typename T, typename = void>
+struct is_tuple_like : std::false_type {
+};
+
+template <typename T>
+struct is_tuple_like<T, std::void_t<decltype(std::tuple_size<T>::value)>> : std::true_type {
+};
+
+/**
+ * @brief Add the size of a range element to `size`, the fields of pairs and tuples separated by
+ *        `field_delimiter`.
+ */
+template <typename T>
+auto add_element_size(const T& element, std::string_view field_delimiter,
+                      std::size_t& size) noexcept -> std::errc
+{
+  if constexpr (is_tuple_like<std::decay_t<T>>::value) {
+    constexpr auto fields = std::tuple_size_v<std::decay_t<T>>;
+    size += fields > 0 ? (fields - 1) * field_delimiter.size() : 0;
+    return std::apply(
+        [field_delimiter, &size](const auto&... field) {
+          std::errc ec{};
+          ((ec = ec == std::errc{} ? add_element_size(field, field_delimiter, size) : ec), ...);
+          return ec;
+        },
+        element);
+  } else {
+    const auto arg = make_format_arg(element);
+    size += arg.size();
+    return arg.ok();
+  }
+}
+
+template <typename T>
+auto write_element(char* out, const T& element, std::string_view field_delimiter) noexcept -> char*
+{
+  if constexpr (is_tuple_like<std::decay_t<T>>::value) {
+    std::apply(
+        [&out, field_delimiter](const auto&... field) {
+          bool first = true;
+          const auto write_field = [&](const auto& value) {
+            if (!first) out = string_arg{field_delimiter}.write(out);
+            first = false;
+            out = write_element(out, value, field_delimiter);
+          };
+          (write_field(field), ...);
+        },
+        element);
+    return out;
+  } else {
+    return make_format_arg(element).write(out);
+  }
+}
+
+template <typename Range>
+auto joined_size(Range& range, std::string_view delimiter,
+                 std::string_view field_delimiter) noexcept -> result<std::size_t, std::errc>
+{
+  std::size_t size = 0;
+  std::size_t count = 0;
+  for (auto&& element : range) {
+    const auto ec = add_element_size(element, field_delimiter, size);
+    if (ec != std::errc{}) return ec;
+    ++count;
+  }
+  return count > 0 ? size + (count - 1) * delimiter.size() : 0;
+}
+
+template <typename Range>
+auto write_joined(char* out, Range& range, std::string_view delimiter,
+                  std::string_view field_delimiter) noexcept -> char*
+{
+  bool first = true;
+  for (auto&& element : range) {
+    if (!first) out = string_arg{delimiter}.write(out);
+    first = false;
+    out = write_element(out, element, field_delimiter);
+  }
+  return out;
+}
+
+template <typename Compiled, typename... FormatArgs, std::size_t... Index>
+auto write_format(char* out, const Compiled& compiled, const std::tuple<FormatArgs...>& args,
+                  std::index_sequence<Index...> /* unused */) noexcept -> char*
+{
+  const auto write_piece = [&out, &compiled](std::size_t piece) {
+    const auto length = compiled.offsets[piece + 1] - compiled.offsets[piece];
+    if (length != 0) std::memcpy(out, compiled.chars.data() + compiled.offsets[piece], length);
+    out += length;
+  };
+
+  ((write_piece(Index), out = std::get<Index>(args).write(out)), ...);
+  write_piece(sizeof...(Index));
+  return out;
+}
+
+template <typename S, typename... Args>
+auto prepare_format(const Args&... args)
+{
+  constexpr auto& compiled = compiled_format_v<S>;
+  static_assert(compiled.offsets.size() - 2 == sizeof...(Args),
+                "The number of '{}' placeholders does not match the number of arguments.");
+  return std::make_tuple(make_format_arg(args)...);
+}
+
+template <typename... FormatArgs>
+auto formatted_size(std::size_t literal_size, const std::tuple<FormatArgs...>& args) noexcept
+    -> result<std::size_t, std::errc>
+{
+  return std::apply(
+      [literal_size](const auto&... arg) -> result<std::size_t, std::errc> {
+        std::errc ec{};
+        ((ec = ec == std::errc{} ? arg.ok() : ec), ...);
+        if (ec != std::errc{}) return ec;
+        return (literal_size + ... + arg.size());
+      },
+      args);
+}
+
+}  // namespace detail
+
+/**
+ * @brief Format values into a buffer, using a format string parsed at compile time.
+ *
+ * Every `{}` in the format string is replaced by the next argument, `{{` and `}}` produce literal
+ * braces. Integers, floating point numbers (shortest representation), `bool`, `char` and anything
+ * convertible to `std::string_view` are supported. A malformed format string or a mismatch between
+ * placeholders and arguments is a compile time error.
+ *
+ * The output is sized exactly in a first pass, then every field is written in place, so the
+ * buffer grows at most once and no temporary strings are created.
+ *
+ * Example:
+ * @snippet format_test.cpp format_to-example
+ *
+ * @param out The string to append to.
+ * @param fmt The format string, wrapped in `BRICKS_FORMAT_STRING`.
+ * @param args The values to format.
+ * @return result<std::size_t, std::errc> The number of characters appended, or the error of a
+ *         failed floating point conversion.
+ */
+template <typename S, typename... Args,
+          typename std::enable_if_t<std::is_base_of_v<detail::format_string, S>, bool> = true>
+auto format_to(std::string& out, S /* fmt */, const Args&... args)
+    -> result<std::size_t, std::errc>
+{
+  constexpr auto& compiled = detail::compiled_format_v<S>;
+  const auto prepared = detail::prepare_format<S>(args...);
+  const auto size = detail::formatted_size(compiled.chars.size(), prepared);
+  if (size.is_error()) return size;
+
+  const auto old_size = out.size();
+  out.resize(old_size + size.unwrap_or(0));
+  detail::write_format(out.data() + old_size, compiled, prepared,
+                       std::index_sequence_for<Args...>{});
+  return size;
+}
+
+/**
+ * @brief Format values into a fixed buffer, using a format string parsed at compile time.
+ *
+ * Like the `std::string` overload, but fails with `std::errc::value_too_large` without writing
+ * anything if the output does not fit into `[first, last)`.
+ *
+ * Example:
+ * @snippet format_test.cpp format_to-buffer-example
+ *
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @param fmt The format string, wrapped in `BRICKS_FORMAT_STRING`.
+ * @param args The values to format.
+ * @return result<std::size_t, std::errc> The number of characters written.
+ */
+template <typename S, typename... Args,
+          typename std::enable_if_t<std::is_base_of_v<detail::format_string, S>, bool> = true>
+auto format_to(char* first, char* last, S /* fmt */, const Args&... args)
+    -> result<std::size_t, std::errc>
+{
+  constexpr auto& compiled = detail::compiled_format_v<S>;
+  const auto prepared = detail::prepare_format<S>(args...);
+  const auto size = detail::formatted_size(compiled.chars.size(), prepared);
+  if (size.is_error()) return size;
+  if (size.unwrap_or(0) > static_cast<std::size_t>(last - first)) {
+    return std::errc::value_too_large;
+  }
+
+  detail::write_format(first, compiled, prepared, std::index_sequence_for<Args...>{});
+  return size;
+}
+
+/**
+ * @brief Format the elements of a range into a string, separated by a delimiter.
+ *
+ * Elements are formatted like the arguments of `format_to`. Pairs and tuples, as produced by
+ * `zip` and `enumerate`, are formatted field by field, separated by `field_delimiter`. Any range
+ * that can be iterated twice is supported, including the views of `ranges.hpp`.
+ *
+ * A first pass counts the digits of every element to size the output exactly, the second writes
+ * the elements in place. So the string grows at most once and no temporary strings are created.
+ * Floating point numbers are converted in both passes.
+ *
+ * Example:
+ * @snippet format_test.cpp join_to-example
+ *
+ * @param out The string to append to.
+ * @param range The range to format.
+ * @param delimiter The separator between elements.
+ * @param field_delimiter The separator between the fields of pairs and tuples.
+ * @return result<std::size_t, std::errc> The number of characters appended, or the error of a
+ *         failed floating point conversion.
+ */
+template <typename Range>
+auto join_to(std::string& out, Range&& range, std::string_view delimiter,
+             std::string_view field_delimiter = ":") -> result<std::size_t, std::errc>
+{
+  const auto size = detail::joined_size(range, delimiter, field_delimiter);
+  if (size.is_error()) return size;
+
+  const auto old_size = out.size();
+  out.resize(old_size + size.unwrap_or(0));
+  detail::write_joined(out.data() + old_size, range, delimiter, field_delimiter);
+  return size;
+}
+
+/**
+ * @brief Format the elements of a range into a fixed buffer, separated by a delimiter.
+ *
+ * Like the `std::string` overload, but fails with `std::errc::value_too_large` without writing
+ * anything if the output does not fit into `[first, last)`.
+ *
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @param range The range to format.
+ * @param delimiter The separator between elements.
+ * @param field_delimiter The separator between the fields of pairs and tuples.
+ * @return result<std::size_t, std::errc> The number of characters written.
+ */
+template <typename Range>
+auto join_to(char* first, char* last, Range&& range, std::string_view delimiter,
+             std::string_view field_delimiter = ":") noexcept -> result<std::size_t, std::errc>
+{
+  const auto size = detail::joined_size(range, delimiter, field_delimiter);
+  if (size.is_error()) return size;
+  if (size.unwrap_or(0) > static_cast<std::size_t>(last - first)) {
+    return std::errc::value_too_large;
+  }
+
+  detail::write_joined(first, range, delimiter, field_delimiter);
+  return size;
+}
+
+}  // namespace bricks
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace bricks {
+
+/**
+ * @brief A set of hardware counter values.
+ *
+ * Either the running totals read from `perf_counters` or the difference of two readings, i.e. the
+ * cost of the measured region.
+ */
+struct perf_sample {
+  /** @brief CPU cycles. */
+  std::uint64_t cycles{0};
+  /** @brief Retired instructions. */
+  std::uint64_t instructions{0};
+  /** @brief Last level cache misses. */
+  std::uint64_t cache_misses{0};
+  /** @brief Mispredicted branches. */
+  std::uint64_t branch_misses{0};
+
+  /**
+   * @brief Instructions per cycle.
+   *
+   * @return double The IPC, or 0 if no cycles were counted.
+   */
+  [[nodiscard]] constexpr auto ipc() const noexcept -> double
+  {
+    return cycles == 0 ? 0.0 : static_cast<double>(instructions) / static_cast<double>(cycles);
+  }
+
+  constexpr auto operator+=(const perf_sample& other) noexcept -> perf_sample&
+  {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    cache_misses += other.cache_misses;
+    branch_misses += other.branch_misses;
+    return *this;
+  }
+
+  [[nodiscard]] friend constexpr auto operator-(const perf_sample& lhs,
+                                                const perf_sample& rhs) noexcept -> perf_sample
+  {
+    return {lhs.cycles - rhs.cycles, lhs.instructions - rhs.instructions,
+            lhs.cache_misses - rhs.cache_misses, lhs.branch_misses - rhs.branch_misses};
+  }
+};
+
+/**
+ * @brief Hardware performance counters of the calling thread.
+ *
+ * On Linux, opens cycles, instructions, cache misses and branch misses as one `perf_event_open`
+ * group, so all four are scheduled onto the PMU together and their ratios are meaningful. Counts
+ * are scaled if the kernel had to multiplex the group.
+ *
+ * If the counters are not available (other platforms, `perf_event_paranoid`, containers without
+ * a PMU, ...) every reading is zero, so instrumented code does not need to care. A counter that is
+ * missing on its own, e.g. cache misses in some VMs, stays zero while the others keep working.
+ *
+ * The counters follow the thread that created the object.
+ *
+ * Example:
+ * @snippet perf_counters_test.cpp perf_counters-example
+ */
+class perf_counters {
+ public:
+  /**
+   * @brief RAII region, storing the counter deltas between its construction and destruction.
+   */
+  class scope {
+   public:
+    scope(const perf_counters& counters, perf_sample& out) noexcept
+        : counters_(counters), out_(out), start_(counters.read())
+    {
+    }
+
+    scope(const scope&) = delete;
+    auto operator=(const scope&) -> scope& = delete;
+    scope(scope&&) = delete;
+    auto operator=(scope&&) -> scope& = delete;
+
+    ~scope() { out_ = counters_.read() - start_; }
+
+   private:
+    const perf_counters& counters_;
+    perf_sample& out_;
+    perf_sample start_;
+  };
+
+  /** @brief Open and start the counters. */
+  perf_counters() noexcept { open(); }
+
+  /** @brief Counters cannot be copied. */
+  perf_counters(const perf_counters&) = delete;
+  /** @brief Counters cannot be copied. */
+  auto operator=(const perf_counters&) -> perf_counters& = delete;
+
+  /** @brief Move constructor. */
+  perf_counters(perf_counters&& other) noexcept
+      : fds_(std::exchange(other.fds_, closed_fds())), slots_(other.slots_)
+  {
+  }
+  /** @brief Move assignment operator. */
+  auto operator=(perf_counters&& other) noexcept -> perf_counters&
+  {
+    if (this != &other) {
+      close();
+      fds_ = std::exchange(other.fds_, closed_fds());
+      slots_ = other.slots_;
+    }
+    return *this;
+  }
+
+  /** @brief Stop and close the counters. */
+  ~perf_counters() { close(); }
+
+  /**
+   * @brief Check whether the counters could be opened.
+   *
+   * @return true If at least the cycle counter is running.
+   */
+  [[nodiscard]] auto available() const noexcept -> bool { return fds_[0] != -1; }
+
+  /**
+   * @brief Read the current counter totals.
+   *
+   * @return perf_sample The totals since construction, or zeros if unavailable.
+   */
+  [[nodiscard]] auto read() const noexcept -> perf_sample
+  {
+    perf_sample sample;
+#if defined(__linux__)
+    if (!available()) return sample;
+
+    // Layout of PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING.
+    std::array<std::uint64_t, 3 + counter_count> buffer{};
+    if (::read(fds_[0], buffer.data(), sizeof(buffer)) <= 0) return sample;
+
+    const auto enabled = buffer[1];
+    const auto running = buffer[2];
+    const auto scale = [enabled, running](std::uint64_t value) {
+      if (running == 0 || running == enabled) return value;
+      return static_cast<std::uint64_t>(static_cast<double>(value) * static_cast<double>(enabled) /
+                                        static_cast<double>(running));
+    };
+
+    std::array<std::uint64_t, counter_count> values{};
+    for (std::size_t i = 0; i < counter_count; ++i) {
+      if (slots_[i] != -1) values[i] = scale(buffer[3 + slots_[i]]);
+    }
+    sample = {values[0], values[1], values[2], values[3]};
+#endif
+    return sample;
+  }
+
+  /**
+   * @brief Measure a region.
+   *
+   * @param out The sample the region's counter deltas are written to when it ends.
+   * @return scope The region, ending when it goes out of scope.
+   */
+  [[nodiscard]] auto measure(perf_sample& out) const noexcept -> scope { return {*this, out}; }
+
+ private:
+  static constexpr std::size_t counter_count = 4;
+
+  static constexpr auto closed_fds() noexcept -> std::array<int, counter_count>
+  {
+    return {-1, -1, -1, -1};
+  }
+
+  auto open() noexcept -> void
+  {
+#if defined(__linux__)
+    constexpr std::array<std::uint64_t, counter_count> configs{
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+
+    int next_slot = 0;
+    for (std::size_t i = 0; i < counter_count; ++i) {
+      perf_event_attr attr{};
+      attr.type = PERF_TYPE_HARDWARE;
+      attr.size = sizeof(attr);
+      attr.config = configs[i];
+      attr.disabled = i == 0 ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format =
+          PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+      fds_[i] = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, fds_[0], 0));
+      if (fds_[i] == -1) {
+        if (i == 0) return;
+        continue;
+      }
+      slots_[i] = next_slot++;
+    }
+
+    ::ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ::ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+  }
+
+  auto close() noexcept -> void
+  {
+#if defined(__linux__)
+    for (auto& fd : fds_) {
+      if (fd != -1) ::close(fd);
+      fd = -1;
+    }
+#endif
+  }
+
+  std::array<int, counter_count> fds_{closed_fds()};
+  std::array<int, counter_count> slots_{-1, -1, -1, -1};
+};
+
+}  // namespace bricks
@@ -4,9 +4,14 @@
 #include <functional>
 #include <initializer_list>
 #include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 
+#include "expectation_trace.hpp"
 #include "type_traits.hpp"
 
 namespace bricks {
@@ -28,6 +33,20 @@ class bad_result_access : public std::runtime_error {
 
 namespace detail {
 
+/**
+ * @brief Record a failed expectation in the global trace and throw.
+ *
+ * Kept out of line of the accessors, so that only the failure path builds the exception message.
+ */
+[[noreturn]] inline void fail_expectation(std::string_view message, source_location location)
+{
+  expectation_trace::global().record(location, message);
+  throw bad_result_access{std::string{message}};
+}
+
+template <typename F>
+using enable_if_message_factory_t = std::enable_if_t<std::is_invocable_v<F>, bool>;
+
 /**
  * @brief A container for a value.
  *
@@ -39,11 +58,12 @@ class value_container {
  public:
   using value_type = T;
 
-  explicit value_container(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
+  constexpr explicit value_container(T value) noexcept(std::is_nothrow_move_constructible_v<T>)
       : value_(std::move(value))
   {
   }
-  auto operator=(T value) noexcept(std::is_nothrow_move_assignable_v<T>) -> value_container&
+  constexpr auto operator=(T value) noexcept(std::is_nothrow_move_assignable_v<T>)
+      -> value_container&
   {
     value_ = std::move(value);
     return *this;
@@ -65,9 +85,105 @@ class value_container {
   T value_;
 };
 
+/**
+ * @brief The value of a `result<void, E>`, which holds nothing.
+ */
+template <typename tag>
+class value_container<void, tag> {
+ public:
+  using value_type = void;
+
+  constexpr value_container() noexcept = default;
+
+  constexpr void get() const noexcept {}
+
+  [[nodiscard]] constexpr auto operator==(const value_container& /* other */) const noexcept
+      -> bool
+  {
+    return true;
+  }
+  [[nodiscard]] constexpr auto operator!=(const value_container& /* other */) const noexcept
+      -> bool
+  {
+    return false;
+  }
+};
+
+/**
+ * @brief The value of a `result<T&, E>`, which holds a pointer to the referenced object.
+ *
+ * Like `std::reference_wrapper`, assignment rebinds the reference and comparison compares the
+ * referenced objects. Also like it, it cannot be bound to a temporary, which would dangle.
+ */
+template <typename T, typename tag>
+class value_container<T&, tag> {
+ public:
+  using value_type = T&;
+
+  constexpr explicit value_container(T& value) noexcept : value_(&value) {}
+  explicit value_container(const T&&) = delete;
+  constexpr auto operator=(T& value) noexcept -> value_container&
+  {
+    value_ = &value;
+    return *this;
+  }
+  auto operator=(const T&&) -> value_container& = delete;
+
+  [[nodiscard]] constexpr auto get() const noexcept -> T& { return *value_; }
+
+  [[nodiscard]] constexpr auto operator==(const value_container& other) const noexcept -> bool
+  {
+    return *value_ == *other.value_;
+  }
+  [[nodiscard]] constexpr auto operator!=(const value_container& other) const noexcept -> bool
+  {
+    return !(*this == other);
+  }
+
+ private:
+  T* value_;
+};
+
 struct ok_tag {};
 struct err_tag {};
 
+template <typename T>
+using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+/**
+ * @brief The type of a parameter taking a value of type `T`, ill-formed for `void`.
+ *
+ * Used in member templates, so that `result<void, E>` does not declare functions with `void`
+ * parameters.
+ */
+template <typename T>
+using value_param_t = std::enable_if_t<!std::is_void_v<T>, T>;
+
+/**
+ * @brief The type of a parameter taking a temporary for a reference `T`, ill-formed otherwise.
+ *
+ * Used to delete the overloads of `result<T&, E>` that would bind a reference to a temporary.
+ */
+template <typename T>
+using temporary_param_t =
+    std::enable_if_t<std::is_reference_v<T>, const std::remove_reference_t<T>&&>;
+
+/**
+ * @brief The result of invoking `F` with a value of type `T`, or without arguments for `void`.
+ */
+template <typename F, typename T>
+struct invoke_value_result {
+  using type = std::invoke_result_t<F, T>;
+};
+
+template <typename F>
+struct invoke_value_result<F, void> {
+  using type = std::invoke_result_t<F>;
+};
+
+template <typename F, typename T>
+using invoke_value_result_t = typename invoke_value_result<F, T>::type;
+
 }  // namespace detail
 
 template <typename T>
@@ -76,6 +192,25 @@ using ok = detail::value_container<T, detail::ok_tag>;
 template <typename E>
 using err = detail::value_container<E, detail::err_tag>;
 
+namespace detail {
+
+/**
+ * @brief Invoke `f` and wrap its return value, if any, into an `ok<T>`.
+ */
+template <typename T, typename F>
+constexpr auto invoke_into_ok(F&& f) -> ok<T>
+{
+  // Called directly, `std::invoke` is not constexpr before C++20.
+  if constexpr (std::is_void_v<T>) {
+    std::forward<F>(f)();
+    return ok<void>{};
+  } else {
+    return ok<T>{std::forward<F>(f)()};
+  }
+}
+
+}  // namespace detail
+
 /**
  * @brief A class to represent the result of an operation.
  *
@@ -85,11 +220,25 @@ using err = detail::value_container<E, detail::err_tag>;
  * The value type and the error type can be different. If they are the same, one can use the `ok<T>`
  * and `err<E>` types to construct and assign the result.
  *
+ * `result<void, E>` only reports success or failure, functions applied to its value take no
+ * arguments. `result<T&, E>` refers to an object instead of copying it and only stores a pointer.
+ * Like `std::reference_wrapper`, it is neither constructed from nor unwrapped to a temporary.
+ *
  * Example:
  * @snippet result_test.cpp result-example
+ *
+ * Void and reference results:
+ * @snippet result_test.cpp result-void-example
+ * @snippet result_test.cpp result-reference-example
+ *
+ * Results of literal types can be constructed, assigned, compared, unwrapped and mapped in
+ * constant expressions:
+ * @snippet result_test.cpp result-constexpr-example
  */
 template <typename T, typename E>
 class result {
+  static_assert(!std::is_void_v<E>, "The error type must not be void.");
+
   using variant_t = std::variant<ok<T>, err<E>>;
 
  public:
@@ -113,7 +262,8 @@ class result {
    * @brief Construct a new result object from a value.
    *
    * If the value and error types are the same, one must use the `ok<T>` and `err<E>` types to
-   * construct the result.
+   * construct the result. This includes a `result<T&, T>`, and `result<void, E>` is always
+   * constructed from `ok<void>{}` or an error.
    * Otherwise the value type must be convertible to the value type of the result.
    * And the error type must be convertible to the error type of the result.
    *
@@ -130,14 +280,21 @@ class result {
   {
   }
 
-  template <typename U = T, typename std::enable_if_t<!std::is_same_v<U, E>, bool> = true>
+  template <typename U = T,
+            typename std::enable_if_t<!std::is_same_v<detail::remove_cvref_t<U>, E>, bool> = true>
   // cppcheck-suppress noExplicitConstructor
-  constexpr result(value_type in) noexcept(std::is_nothrow_move_constructible_v<ok<T>>)  // NOLINT
-      : value_(ok<T>{std::move(in)})
+  constexpr result(detail::value_param_t<U> in) noexcept(  // NOLINT
+      std::is_nothrow_move_constructible_v<ok<T>>)
+      : value_(ok<T>{std::forward<U>(in)})
   {
   }
 
-  template <typename U = E, typename std::enable_if_t<!std::is_same_v<T, U>, bool> = true>
+  template <typename U = T,
+            typename std::enable_if_t<!std::is_same_v<detail::remove_cvref_t<U>, E>, bool> = true>
+  result(detail::temporary_param_t<U> in) = delete;
+
+  template <typename U = E,
+            typename std::enable_if_t<!std::is_same_v<detail::remove_cvref_t<T>, U>, bool> = true>
   // cppcheck-suppress noExplicitConstructor
   constexpr result(error_type in) noexcept(std::is_nothrow_move_constructible_v<err<E>>)  // NOLINT
       : value_(err<E>{std::move(in)})
@@ -163,11 +320,11 @@ class result {
       std::is_nothrow_constructible_v<err<E>, error_type>) -> result
   {
     static_assert(std::is_invocable_v<F>, "f must be invocable");
-    static_assert(std::is_constructible_v<T, std::invoke_result_t<F>>,
+    static_assert(std::is_void_v<T> || std::is_constructible_v<T, std::invoke_result_t<F>>,
                   "value_type must be constructible from the result of f");
 
     try {
-      return ok<T>{std::invoke(std::forward<F>(f))};
+      return detail::invoke_into_ok<T>(std::forward<F>(f));
     } catch (...) {
       return err<E>{error_value};
     }
@@ -217,12 +374,12 @@ class result {
           std::is_nothrow_constructible_v<result<T, E>, std::invoke_result_t<OnError>>) -> result
   {
     static_assert(std::is_invocable_v<F>, "f must be invocable");
-    static_assert(std::is_constructible_v<ok<T>, std::invoke_result_t<F>>,
+    static_assert(std::is_void_v<T> || std::is_constructible_v<ok<T>, std::invoke_result_t<F>>,
                   "value_type must be constructible from the result of F");
     static_assert(std::is_invocable_v<OnError>, "on_error must be invocable");
 
     try {
-      return ok<T>{std::invoke(std::forward<F>(f))};
+      return detail::invoke_into_ok<T>(std::forward<F>(f));
     } catch (...) {
       return {std::invoke(std::forward<OnError>(on_error))};
     }
@@ -244,11 +401,12 @@ class result {
   {
     using param_t = std::decay_t<U>;
     if constexpr (std::is_same_v<param_t, ok<T>> || std::is_same_v<param_t, err<E>>) {
-      value_ = std::move(in);
-    } else if constexpr (std::is_same_v<param_t, T> || std::is_convertible_v<param_t, T>) {
-      value_ = ok<T>{std::move(in)};
+      assign(std::move(in));
+    } else if constexpr (!std::is_void_v<T> && !std::is_reference_v<T> &&
+                         (std::is_same_v<param_t, T> || std::is_convertible_v<param_t, T>)) {
+      assign(ok<T>{std::move(in)});
     } else if constexpr (std::is_same_v<param_t, E> || std::is_convertible_v<param_t, E>) {
-      value_ = err<E>{std::move(in)};
+      assign(err<E>{std::move(in)});
     } else if constexpr (std::is_same_v<T, E>) {
       static_assert(always_false_v<U>,
                     "Since the value and error types are the same, use ok<T> or "
@@ -290,18 +448,64 @@ class result {
   /**
    * @brief Returns the value of the result.
    *
-   * Throws a `bad_result_access` if the result is an error, with the provided message.
+   * Throws a `bad_result_access` if the result is an error, with the provided message. The failure
+   * is also recorded in `expectation_trace::global()`, together with the location of the call.
+   * The message is only copied on failure, so the success path never allocates.
    *
    * Example:
    * @snippet result_test.cpp result-expect-example
    *
    * @param msg The message to use in the exception.
+   * @param location The location of the call.
+   * @return value_type The value of the result.
+   */
+  [[nodiscard]] constexpr auto expect(std::string_view msg,
+                                      source_location location = source_location::current()) const
+      -> value_type
+  {
+    if (is_error()) detail::fail_expectation(msg, location);
+    return std::get<ok<T>>(value_).get();
+  }
+
+  /**
+   * @brief Returns the value of the result.
+   *
+   * Like the `std::string_view` overload, but the length of the message is only computed on
+   * failure.
+   *
+   * @param msg The null terminated message to use in the exception.
+   * @param location The location of the call.
+   * @return value_type The value of the result.
+   */
+  [[nodiscard]] constexpr auto expect(const char* msg,
+                                      source_location location = source_location::current()) const
+      -> value_type
+  {
+    if (is_error()) detail::fail_expectation(msg, location);
+    return std::get<ok<T>>(value_).get();
+  }
+
+  /**
+   * @brief Returns the value of the result.
+   *
+   * Like the `std::string_view` overload, but the message is built by calling `make_message`, which
+   * only happens on failure. Use it for messages that have to be formatted.
+   *
+   * Example:
+   * @snippet result_test.cpp result-expect-lazy-example
+   *
+   * @param make_message Returns the message, as anything convertible to `std::string_view`.
+   * @param location The location of the call.
    * @return value_type The value of the result.
    */
-  [[nodiscard]] constexpr auto expect(const std::string& msg) const -> value_type
+  template <typename F, detail::enable_if_message_factory_t<F> = true>
+  [[nodiscard]] constexpr auto expect(F&& make_message,
+                                      source_location location = source_location::current()) const
+      -> value_type
   {
     if (is_error()) {
-      throw bad_result_access{msg};
+      const auto& msg = std::invoke(std::forward<F>(make_message));
+      detail::fail_expectation(msg, location);
     }
     return std::get<ok<T>>(value_).get();
   }
@@ -314,28 +518,70 @@ class result {
    * Example:
    * @snippet result_test.cpp result-unwrap-example
    *
+   * @param location The location of the call.
    * @return value_type The value of the result.
    */
-  [[nodiscard]] constexpr auto unwrap() const -> value_type
+  [[nodiscard]] constexpr auto unwrap(source_location location = source_location::current()) const
+      -> value_type
   {
-    return expect("Called `unwrap` on a result that is an error.");
+    return expect("Called `unwrap` on a result that is an error.", location);
   }
 
   /**
    * @brief Returns the error of the result.
    *
-   * Throws a `bad_result_access` if the result is a value, with the provided message.
+   * Throws a `bad_result_access` if the result is a value, with the provided message. Like
+   * `expect`, the failure is recorded in `expectation_trace::global()`.
    *
    * Example:
    * @snippet result_test.cpp result-expect-error-example
    *
    * @param msg The message to use in the exception.
+   * @param location The location of the call.
+   * @return error_type The error of the result.
+   */
+  [[nodiscard]] constexpr auto expect_error(
+      std::string_view msg, source_location location = source_location::current()) const
+      -> error_type
+  {
+    if (is_value()) detail::fail_expectation(msg, location);
+    return std::get<err<E>>(value_).get();
+  }
+
+  /**
+   * @brief Returns the error of the result.
+   *
+   * Like the `std::string_view` overload, but the length of the message is only computed on
+   * failure.
+   *
+   * @param msg The null terminated message to use in the exception.
+   * @param location The location of the call.
+   * @return error_type The error of the result.
+   */
+  [[nodiscard]] constexpr auto expect_error(
+      const char* msg, source_location location = source_location::current()) const -> error_type
+  {
+    if (is_value()) detail::fail_expectation(msg, location);
+    return std::get<err<E>>(value_).get();
+  }
+
+  /**
+   * @brief Returns the error of the result.
+   *
+   * Like the `std::string_view` overload, but the message is built by calling `make_message`, which
+   * only happens on failure.
+   *
+   * @param make_message Returns the message, as anything convertible to `std::string_view`.
+   * @param location The location of the call.
    * @return error_type The error of the result.
    */
-  [[nodiscard]] constexpr auto expect_error(const std::string& msg) const -> error_type
+  template <typename F, detail::enable_if_message_factory_t<F> = true>
+  [[nodiscard]] constexpr auto expect_error(
+      F&& make_message, source_location location = source_location::current()) const -> error_type
   {
     if (is_value()) {
-      throw bad_result_access{msg};
+      const auto& msg = std::invoke(std::forward<F>(make_message));
+      detail::fail_expectation(msg, location);
     }
     return std::get<err<E>>(value_).get();
   }
@@ -348,11 +594,13 @@ class result {
    * Example:
    * @snippet result_test.cpp result-unwrap-error-example
    *
+   * @param location The location of the call.
    * @return error_type The error of the result.
    */
-  [[nodiscard]] constexpr auto unwrap_error() const -> error_type
+  [[nodiscard]] constexpr auto unwrap_error(
+      source_location location = source_location::current()) const -> error_type
   {
-    return expect_error("Called `unwrap_error` on a result that is a value.");
+    return expect_error("Called `unwrap_error` on a result that is a value.", location);
   }
 
   /**
@@ -367,14 +615,19 @@ class result {
    * @param default_value The default value to return if the result is an error.
    * @return value_type The value of the result.
    */
-  [[nodiscard]] constexpr auto unwrap_or(value_type default_value) const noexcept -> value_type
+  template <typename U = T>
+  [[nodiscard]] constexpr auto unwrap_or(detail::value_param_t<U> default_value) const noexcept
+      -> value_type
   {
     if (is_error()) {
-      return default_value;
+      return std::forward<U>(default_value);
     }
     return std::get<ok<T>>(value_).get();
   }
 
+  template <typename U = T>
+  auto unwrap_or(detail::temporary_param_t<U> default_value) const -> value_type = delete;
+
   /**
    * @brief Returns the value of the result or a default constructed value.
    *
@@ -430,12 +683,14 @@ class result {
    */
   template <typename F>
   [[nodiscard]] constexpr auto map(F&& f) const
-      -> result<std::invoke_result_t<F, value_type>, error_type>
+      -> result<detail::invoke_value_result_t<F, value_type>, error_type>
   {
+    using mapped_type = detail::invoke_value_result_t<F, value_type>;
     if (is_error()) {
-      return {std::get<err<E>>(value_).get()};
+      return {std::get<err<E>>(value_)};
     }
-    return {ok<std::invoke_result_t<F, value_type>>{f(std::get<ok<T>>(value_).get())}};
+    return {detail::invoke_into_ok<mapped_type>(
+        [this, &f]() -> mapped_type { return invoke_with_value(std::forward<F>(f)); })};
   }
 
   /**
@@ -455,7 +710,7 @@ class result {
       -> result<value_type, std::invoke_result_t<F, error_type>>
   {
     if (is_value()) {
-      return {std::get<ok<T>>(value_).get()};
+      return {std::get<ok<T>>(value_)};
     }
     return {err<std::invoke_result_t<F, error_type>>{f(std::get<err<E>>(value_).get())}};
   }
@@ -471,13 +726,13 @@ class result {
    * @return std::invoke_result_t<F, value_type> The result of the function.
    */
   template <typename F>
-  [[nodiscard]] constexpr auto map_or(std::invoke_result_t<F, value_type> default_value,
-                                      F&& f) const -> std::invoke_result_t<F, value_type>
+  [[nodiscard]] constexpr auto map_or(detail::invoke_value_result_t<F, value_type> default_value,
+                                      F&& f) const -> detail::invoke_value_result_t<F, value_type>
   {
     if (is_error()) {
       return default_value;
     }
-    return f(std::get<ok<T>>(value_).get());
+    return invoke_with_value(std::forward<F>(f));
   }
 
   /**
@@ -495,12 +750,12 @@ class result {
    */
   template <typename F, typename G>
   [[nodiscard]] constexpr auto map_or_else(G&& default_f, F&& f) const
-      -> std::invoke_result_t<F, value_type>
+      -> detail::invoke_value_result_t<F, value_type>
   {
     if (is_error()) {
       return default_f(std::get<err<E>>(value_).get());
     }
-    return f(std::get<ok<T>>(value_).get());
+    return invoke_with_value(std::forward<F>(f));
   }
 
   /**
@@ -519,7 +774,7 @@ class result {
       -> result<U, error_type>
   {
     if (is_error()) {
-      return {std::get<err<E>>(value_).get()};
+      return {std::get<err<E>>(value_)};
     }
     return {res};
   }
@@ -537,12 +792,12 @@ class result {
    */
   template <typename Op>
   [[nodiscard]] constexpr auto and_then(Op&& op) const
-      -> result<typename std::invoke_result_t<Op, value_type>::value_type, error_type>
+      -> result<typename detail::invoke_value_result_t<Op, value_type>::value_type, error_type>
   {
     if (is_error()) {
-      return {std::get<err<E>>(value_).get()};
+      return {std::get<err<E>>(value_)};
     }
-    return {op(std::get<ok<T>>(value_).get())};
+    return {invoke_with_value(std::forward<Op>(op))};
   }
 
   /**
@@ -561,7 +816,7 @@ class result {
       -> result<value_type, F>
   {
     if (is_value()) {
-      return {std::get<ok<T>>(value_).get()};
+      return {std::get<ok<T>>(value_)};
     }
     return {res};
   }
@@ -582,7 +837,7 @@ class result {
       -> result<value_type, typename std::invoke_result_t<Op, error_type>::error_type>
   {
     if (is_value()) {
-      return {std::get<ok<T>>(value_).get()};
+      return {std::get<ok<T>>(value_)};
     }
     return {op(std::get<err<E>>(value_).get())};
   }
@@ -600,6 +855,36 @@ class result {
       -> std::size_t;
 
  private:
+  /**
+   * @brief Call `f` with the value, or without arguments for `result<void, E>`.
+   */
+  template <typename F>
+  constexpr auto invoke_with_value(F&& f) const -> detail::invoke_value_result_t<F, value_type>
+  {
+    if constexpr (std::is_void_v<T>) {
+      return std::forward<F>(f)();
+    } else {
+      return std::forward<F>(f)(std::get<ok<T>>(value_).get());
+    }
+  }
+
+  /**
+   * @brief Replace the content with `ok<T>` or `err<E>`.
+   *
+   * The converting assignment of `std::variant` is not constexpr before C++20, but its trivial
+   * move assignment is. So results of trivially copyable types are assignable in constant
+   * expressions.
+   */
+  template <typename Alternative>
+  constexpr void assign(Alternative&& alternative)
+  {
+    if constexpr (std::is_trivially_copyable_v<variant_t>) {
+      value_ = variant_t{std::forward<Alternative>(alternative)};
+    } else {
+      value_ = std::forward<Alternative>(alternative);
+    }
+  }
+
   variant_t value_;
 };
 
@@ -612,7 +897,8 @@ class result {
  * error.
  *
  * If it is desired to construct the error from some other value, use `result::from_try_or` or
- * `result::from_try_or_default` instead.
+ * `result::from_try_or_default` instead, or `result_from_try<Mapping>` to map exception types to
+ * error values without an `std::exception_ptr`.
  *
  * Example:
  * @snippet result_test.cpp result-from-try-example
@@ -625,12 +911,117 @@ template <typename F, typename std::enable_if_t<std::is_invocable_v<F>, bool> =
     -> result<std::invoke_result_t<F>, std::exception_ptr>
 {
   try {
-    return ok<std::invoke_result_t<F>>{std::invoke(std::forward<F>(f))};
+    return detail::invoke_into_ok<std::invoke_result_t<F>>(std::forward<F>(f));
   } catch (...) {
     return err<std::exception_ptr>{std::current_exception()};
   }
 }
 
+/**
+ * @brief Maps exceptions of type `Exception`, or derived from it, to the error value `Error`.
+ * @relates exception_mapping
+ */
+template <typename Exception, auto Error>
+struct catch_as {
+  /** @brief The type of exception to catch. */
+  using exception_type = Exception;
+  /** @brief The error value the exception is mapped to. */
+  static constexpr auto error = Error;
+};
+
+/**
+ * @brief A compile time list of `catch_as` mappings of exception types to error values.
+ *
+ * The mappings are tried in order, like the handlers of a `try` block, so more derived exception
+ * types have to come first. All error values must have the same type.
+ *
+ * Example:
+ * @snippet result_test.cpp result-from-try-mapping-example
+ */
+template <typename First, typename... Rest>
+struct exception_mapping {
+  /** @brief The type of the error values. */
+  using error_type = std::remove_cv_t<decltype(First::error)>;
+
+  static_assert((std::is_same_v<error_type, std::remove_cv_t<decltype(Rest::error)>> && ...),
+                "All error values of an exception_mapping must have the same type.");
+};
+
+namespace detail {
+
+template <typename T, typename E, typename... Catches, typename F>
+auto try_mapped(F&& f) -> result<T, E>;
+
+/**
+ * @brief Catch the last mapping around a call with all the others.
+ */
+template <typename T, typename E, typename... Catches, typename F, std::size_t... Index>
+auto try_mapped_last(F&& f, std::index_sequence<Index...> /* unused */) -> result<T, E>
+{
+  using last = std::tuple_element_t<sizeof...(Catches) - 1, std::tuple<Catches...>>;
+  try {
+    return try_mapped<T, E, std::tuple_element_t<Index, std::tuple<Catches...>>...>(
+        std::forward<F>(f));
+  } catch (const typename last::exception_type& /* unused */) {
+    return err<E>{last::error};
+  }
+}
+
+/**
+ * @brief Call `f` inside one `try` block per mapping, the first mapping innermost.
+ */
+template <typename T, typename E, typename... Catches, typename F>
+auto try_mapped(F&& f) -> result<T, E>
+{
+  if constexpr (sizeof...(Catches) == 0) {
+    return invoke_into_ok<T>(std::forward<F>(f));
+  } else {
+    return try_mapped_last<T, E, Catches...>(std::forward<F>(f),
+                                             std::make_index_sequence<sizeof...(Catches) - 1>{});
+  }
+}
+
+template <typename T, typename Mapping>
+struct mapped_result;
+
+template <typename T, typename... Catches>
+struct mapped_result<T, exception_mapping<Catches...>> {
+  using type = result<T, typename exception_mapping<Catches...>::error_type>;
+
+  template <typename F>
+  static auto invoke(F&& f) -> type
+  {
+    return try_mapped<T, typename exception_mapping<Catches...>::error_type, Catches...>(
+        std::forward<F>(f));
+  }
+};
+
+}  // namespace detail
+
+/**
+ * @brief Construct a new result object from an operation that might throw, mapping exception
+ *        types to error values.
+ *
+ * Exceptions are caught by reference and translated to the error value of the first matching
+ * `catch_as` of `Mapping`, without capturing an `std::exception_ptr`. So no allocation happens
+ * beyond the one of the exception itself, and the result is as small as its value and error.
+ * Exceptions not in the mapping propagate.
+ *
+ * Example:
+ * @snippet result_test.cpp result-from-try-mapping-example
+ *
+ * @tparam Mapping An `exception_mapping` of the exceptions to catch.
+ * @param f The function to wrap.
+ * @return result<std::invoke_result_t<F>, typename Mapping::error_type> The result of the function.
+ */
+template <typename Mapping, typename F,
+          typename std::enable_if_t<std::is_invocable_v<F>, bool> = true>
+[[nodiscard]] auto result_from_try(F&& f)
+    -> result<std::invoke_result_t<F>, typename Mapping::error_type>
+{
+  return detail::mapped_result<std::invoke_result_t<F>, Mapping>::invoke(std::forward<F>(f));
+}
+
 }  // namespace bricks
 
 /**
@@ -658,6 +1049,10 @@ struct std::hash<bricks::detail::value_container<T, tag>> {
   [[nodiscard]] constexpr auto operator()(
       const bricks::detail::value_container<T, tag>& r) const noexcept -> std::size_t
   {
-    return hash<T>{}(r.get());
+    if constexpr (std::is_void_v<T>) {
+      return 0;
+    } else {
+      return hash<bricks::detail::remove_cvref_t<T>>{}(r.get());
+    }
   }
 };
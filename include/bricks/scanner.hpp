@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <system_error>
+
+#include "charconv.hpp"
+#include "result.hpp"
+
+namespace bricks {
+
+/**
+ * @brief A cursor parsing consecutive fields from a string in a single pass.
+ *
+ * Each successful read advances the cursor past the consumed characters, a failed read leaves it
+ * where it was. Values are parsed in place with `parse_prefix`, so no substrings are created and
+ * every character is looked at once.
+ *
+ * The scanner does not own the input, which must outlive it.
+ *
+ * Example:
+ * @snippet scanner_test.cpp scanner-example
+ */
+class scanner {
+ public:
+  /**
+   * @brief Construct a scanner at the start of `input`.
+   */
+  constexpr explicit scanner(std::string_view input) noexcept : input_(input) {}
+
+  /**
+   * @brief Parse a number at the cursor.
+   *
+   * Example:
+   * @snippet scanner_test.cpp scanner-example
+   *
+   * @tparam T The type of number to parse.
+   * @return result<T, std::errc> The number, or the error of `std::from_chars`.
+   */
+  template <typename T>
+  auto read() noexcept -> result<T, std::errc>
+  {
+    auto parsed = parse_prefix<T>(remaining());
+    if (parsed.is_error()) return parsed.unwrap_error();
+
+    const auto [value, consumed] = parsed.unwrap_or({});
+    pos_ += consumed;
+    return value;
+  }
+
+  /**
+   * @brief Parse a number at the cursor that must be followed by `delimiter` or the end.
+   *
+   * The delimiter is consumed as well, so a line of delimited values can be read with consecutive
+   * calls.
+   *
+   * Example:
+   * @snippet scanner_test.cpp scanner-read-field-example
+   *
+   * @tparam T The type of number to parse.
+   * @param delimiter The character separating the fields.
+   * @return result<T, std::errc> The number, `std::errc::invalid_argument` if it is not followed by
+   *         the delimiter, or the error of `std::from_chars`.
+   */
+  template <typename T>
+  auto read_field(char delimiter) noexcept -> result<T, std::errc>
+  {
+    const auto start = pos_;
+    auto value = read<T>();
+    if (value.is_error()) return value;
+
+    if (!at_end() && !consume(delimiter)) {
+      pos_ = start;
+      return std::errc::invalid_argument;
+    }
+    return value;
+  }
+
+  /**
+   * @brief Return the characters up to `delimiter` and move the cursor past the delimiter.
+   *
+   * If the delimiter is not found, returns the rest of the input.
+   *
+   * @param delimiter The character ending the token.
+   * @return std::string_view The token, without the delimiter.
+   */
+  constexpr auto read_until(char delimiter) noexcept -> std::string_view
+  {
+    const auto rest = remaining();
+    const auto end = rest.find(delimiter);
+    if (end == std::string_view::npos) {
+      pos_ = input_.size();
+      return rest;
+    }
+    pos_ += end + 1;
+    return rest.substr(0, end);
+  }
+
+  /**
+   * @brief Consume `expected` if the input continues with it.
+   *
+   * @return true If the character was consumed.
+   */
+  constexpr auto consume(char expected) noexcept -> bool
+  {
+    if (at_end() || input_[pos_] != expected) return false;
+    ++pos_;
+    return true;
+  }
+
+  /**
+   * @brief Consume `expected` if the input continues with it.
+   *
+   * @return true If the string was consumed.
+   */
+  constexpr auto consume(std::string_view expected) noexcept -> bool
+  {
+    if (remaining().substr(0, expected.size()) != expected) return false;
+    pos_ += expected.size();
+    return true;
+  }
+
+  /**
+   * @brief Move the cursor past spaces, tabs and line breaks.
+   */
+  constexpr auto skip_whitespace() noexcept -> void
+  {
+    while (!at_end() && (input_[pos_] == ' ' || input_[pos_] == '\t' || input_[pos_] == '\n' ||
+                         input_[pos_] == '\r')) {
+      ++pos_;
+    }
+  }
+
+  /** @brief The characters after the cursor. */
+  [[nodiscard]] constexpr auto remaining() const noexcept -> std::string_view
+  {
+    return input_.substr(pos_);
+  }
+
+  /** @brief The offset of the cursor into the input. */
+  [[nodiscard]] constexpr auto position() const noexcept -> std::size_t { return pos_; }
+
+  /** @brief Whether the whole input has been consumed. */
+  [[nodiscard]] constexpr auto at_end() const noexcept -> bool { return pos_ == input_.size(); }
+
+ private:
+  std::string_view input_;
+  std::size_t pos_{0};
+};
+
+}  // namespace bricks
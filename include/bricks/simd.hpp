@@ -0,0 +1,417 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+
+#include "cpu_features.hpp"
+
+#ifdef BRICKS_CPU_X86
+#include <immintrin.h>
+#endif
+
+namespace bricks {
+
+/**
+ * @brief The backends of `simd`.
+ */
+namespace simd_abi {
+
+/** @brief An array of lanes, processed by loops the compiler may vectorize. */
+struct scalar {
+};
+
+#ifdef BRICKS_CPU_X86
+/** @brief 16 byte vectors, using SSE2. `shuffle` needs SSSE3. */
+struct sse2 {
+};
+
+/** @brief 32 byte vectors, using AVX2. Only use these in functions targeting AVX2. */
+struct avx2 {
+};
+#endif
+
+}  // namespace simd_abi
+
+namespace detail {
+
+template <std::size_t Bytes>
+struct native_simd_abi {
+  using type = simd_abi::scalar;
+};
+
+#ifdef BRICKS_CPU_X86
+template <>
+struct native_simd_abi<16> {
+  using type = simd_abi::sse2;
+};
+
+#ifdef __AVX2__
+// Only the default if the whole program targets AVX2, kernels selected at runtime name the ABI.
+template <>
+struct native_simd_abi<32> {
+  using type = simd_abi::avx2;
+};
+#endif
+#endif
+
+template <typename T>
+constexpr auto all_ones() noexcept -> T
+{
+  return static_cast<T>(~std::make_unsigned_t<T>{});
+}
+
+}  // namespace detail
+
+/**
+ * @brief A fixed size vector of `N` integers of type `T`, processed with one instruction per
+ *        operation where the CPU allows it.
+ *
+ * Kernels are written once against this interface and instantiated for each backend, e.g. with
+ * `simd<T, 16 / sizeof(T)>` for SSE2 and `simd<T, 32 / sizeof(T)>` for AVX2, and selected with
+ * `cpu_dispatch`. Comparisons return vectors with all bits of the matching lanes set, like the
+ * x86 instructions, which `to_bitmask` turns into one bit per lane.
+ *
+ * The AVX2 backend only works in functions compiled for AVX2, e.g. with
+ * `__attribute__((target("avx2"), flatten))`, which also inlines the kernel. It is only the default
+ * for 32 bytes if the program is compiled for AVX2, e.g. with `-mavx2`, otherwise such kernels
+ * have to name `simd_abi::avx2`.
+ *
+ * Example:
+ * @snippet simd_test.cpp simd-example
+ *
+ * @tparam T The integral type of the lanes.
+ * @tparam N The number of lanes.
+ * @tparam Abi The backend, by default SSE2 for 16 bytes on x86-64, AVX2 for 32 bytes if the
+ *         program is compiled for AVX2, otherwise `simd_abi::scalar`.
+ */
+template <typename T, std::size_t N,
+          typename Abi = typename detail::native_simd_abi<N * sizeof(T)>::type>
+class simd;
+
+template <typename T, std::size_t N>
+class simd<T, N, simd_abi::scalar> {
+  static_assert(std::is_integral_v<T>, "The lanes have to be integers.");
+  static_assert(N > 0 && N <= 64, "The bitmask of the lanes has to fit into 64 bits.");
+
+ public:
+  using value_type = T;
+  using abi_type = simd_abi::scalar;
+
+  /** @brief The number of lanes. */
+  [[nodiscard]] static constexpr auto size() noexcept -> std::size_t { return N; }
+
+  /** @brief Load `N` values, without alignment requirements. */
+  [[nodiscard]] static auto load(const T* data) noexcept -> simd
+  {
+    simd result;
+    std::memcpy(result.lanes_.data(), data, sizeof(result.lanes_));
+    return result;
+  }
+
+  /** @brief A vector with all lanes set to `value`. */
+  [[nodiscard]] static auto broadcast(T value) noexcept -> simd
+  {
+    simd result;
+    result.lanes_.fill(value);
+    return result;
+  }
+
+  /** @brief Store the `N` values, without alignment requirements. */
+  void store(T* data) const noexcept { std::memcpy(data, lanes_.data(), sizeof(lanes_)); }
+
+  /** @brief All bits set in the lanes that are equal, none in the others. */
+  [[nodiscard]] friend auto operator==(const simd& lhs, const simd& rhs) noexcept -> simd
+  {
+    simd result;
+    for (std::size_t i = 0; i < N; ++i) {
+      result.lanes_[i] = lhs.lanes_[i] == rhs.lanes_[i] ? detail::all_ones<T>() : T{0};
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend auto operator&(const simd& lhs, const simd& rhs) noexcept -> simd
+  {
+    simd result;
+    for (std::size_t i = 0; i < N; ++i) {
+      result.lanes_[i] = static_cast<T>(lhs.lanes_[i] & rhs.lanes_[i]);
+    }
+    return result;
+  }
+
+  [[nodiscard]] friend auto operator|(const simd& lhs, const simd& rhs) noexcept -> simd
+  {
+    simd result;
+    for (std::size_t i = 0; i < N; ++i) {
+      result.lanes_[i] = static_cast<T>(lhs.lanes_[i] | rhs.lanes_[i]);
+    }
+    return result;
+  }
+
+  /** @brief The top bit of every lane, the first lane in the lowest bit. */
+  [[nodiscard]] auto to_bitmask() const noexcept -> std::uint64_t
+  {
+    constexpr auto top_bit = 8 * sizeof(T) - 1;
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      const auto lane = static_cast<std::make_unsigned_t<T>>(lanes_[i]);
+      mask |= static_cast<std::uint64_t>(lane >> top_bit) << i;
+    }
+    return mask;
+  }
+
+  /**
+   * @brief Pick bytes by index within each group of 16, like the x86 `pshufb` instruction.
+   *
+   * Lanes whose index has the top bit set become zero.
+   */
+  [[nodiscard]] auto shuffle(const simd& indices) const noexcept -> simd
+  {
+    static_assert(sizeof(T) == 1, "Only bytes can be shuffled.");
+    simd result;
+    for (std::size_t i = 0; i < N; ++i) {
+      const auto index = static_cast<std::uint8_t>(indices.lanes_[i]);
+      const auto source = (i & ~std::size_t{15}) + (index & 15U);
+      result.lanes_[i] = (index & 0x80U) != 0 || source >= N ? T{0} : lanes_[source];
+    }
+    return result;
+  }
+
+ private:
+  std::array<T, N> lanes_{};
+};
+
+#ifdef BRICKS_CPU_X86
+
+template <typename T, std::size_t N>
+class simd<T, N, simd_abi::sse2> {
+  static_assert(std::is_integral_v<T>, "The lanes have to be integers.");
+  static_assert(N * sizeof(T) == 16, "SSE2 vectors have 16 bytes.");
+
+ public:
+  using value_type = T;
+  using abi_type = simd_abi::sse2;
+
+  [[nodiscard]] static constexpr auto size() noexcept -> std::size_t { return N; }
+
+  [[nodiscard]] static auto load(const T* data) noexcept -> simd
+  {
+    return simd{_mm_loadu_si128(reinterpret_cast<const __m128i*>(data))};  // NOLINT
+  }
+
+  [[nodiscard]] static auto broadcast(T value) noexcept -> simd
+  {
+    if constexpr (sizeof(T) == 1) return simd{_mm_set1_epi8(static_cast<char>(value))};
+    if constexpr (sizeof(T) == 2) return simd{_mm_set1_epi16(static_cast<short>(value))};
+    if constexpr (sizeof(T) == 4) return simd{_mm_set1_epi32(static_cast<int>(value))};
+    if constexpr (sizeof(T) == 8) return simd{_mm_set1_epi64x(static_cast<long long>(value))};
+  }
+
+  void store(T* data) const noexcept
+  {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(data), value_);  // NOLINT
+  }
+
+  [[nodiscard]] friend auto operator==(const simd& lhs, const simd& rhs) noexcept -> simd
+  {
+    if constexpr (sizeof(T) == 1) return simd{_mm_cmpeq_epi8(lhs.value_, rhs.value_)};
+    if constexpr (sizeof(T) == 2) return simd{_mm_cmpeq_epi16(lhs.value_, rhs.value_)};
+    if constexpr (sizeof(T) == 4) return simd{_mm_cmpeq_epi32(lhs.value_, rhs.value_)};
+    if constexpr (sizeof(T) == 8) {
+      // SSE2 has no 64 bit comparison, both halves have to be equal.
+      const __m128i halves = _mm_cmpeq_epi32(lhs.value_, rhs.value_);
+      return simd{_mm_and_si128(halves, _mm_shuffle_epi32(halves, _MM_SHUFFLE(2, 3, 0, 1)))};
+    }
+  }
+
+  [[nodiscard]] friend auto operator&(const simd& lhs, const simd& rhs) noexcept -> simd
+  {
+    return simd{_mm_and_si128(lhs.value_, rhs.value_)};
+  }
+
+  [[nodiscard]] friend auto operator|(const simd& lhs, const simd& rhs) noexcept -> simd
+  {
+    return simd{_mm_or_si128(lhs.value_, rhs.value_)};
+  }
+
+  [[nodiscard]] auto to_bitmask() const noexcept -> std::uint64_t
+  {
+    if constexpr (sizeof(T) == 1) return static_cast<unsigned>(_mm_movemask_epi8(value_));
+    if constexpr (sizeof(T) == 2) {
+      // Saturating to bytes keeps the sign.
+      return static_cast<unsigned>(_mm_movemask_epi8(_mm_packs_epi16(value_, _mm_setzero_si128())));
+    }
+    if constexpr (sizeof(T) == 4) {
+      return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(value_)));
+    }
+    if constexpr (sizeof(T) == 8) {
+      return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(value_)));
+    }
+  }
+
+  __attribute__((target("ssse3"))) [[nodiscard]] auto shuffle(const simd& indices) const noexcept
+      -> simd
+  {
+    static_assert(sizeof(T) == 1, "Only bytes can be shuffled.");
+    return simd{_mm_shuffle_epi8(value_, indices.value_)};
+  }
+
+ private:
+  explicit simd(__m128i value) noexcept : value_(value) {}
+
+  __m128i value_;
+};
+
+template <typename T, std::size_t N>
+class simd<T, N, simd_abi::avx2> {
+  static_assert(std::is_integral_v<T>, "The lanes have to be integers.");
+  static_assert(N * sizeof(T) == 32, "AVX2 vectors have 32 bytes.");
+
+ public:
+  using value_type = T;
+  using abi_type = simd_abi::avx2;
+
+  [[nodiscard]] static constexpr auto size() noexcept -> std::size_t { return N; }
+
+  __attribute__((target("avx2"))) [[nodiscard]] static auto load(const T* data) noexcept -> simd
+  {
+    return simd{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data))};  // NOLINT
+  }
+
+  __attribute__((target("avx2"))) [[nodiscard]] static auto broadcast(T value) noexcept -> simd
+  {
+    if constexpr (sizeof(T) == 1) return simd{_mm256_set1_epi8(static_cast<char>(value))};
+    if constexpr (sizeof(T) == 2) return simd{_mm256_set1_epi16(static_cast<short>(value))};
+    if constexpr (sizeof(T) == 4) return simd{_mm256_set1_epi32(static_cast<int>(value))};
+    if constexpr (sizeof(T) == 8) return simd{_mm256_set1_epi64x(static_cast<long long>(value))};
+  }
+
+  __attribute__((target("avx2"))) void store(T* data) const noexcept
+  {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(data), value_);  // NOLINT
+  }
+
+  __attribute__((target("avx2"))) [[nodiscard]] friend auto operator==(const simd& lhs,
+                                                                       const simd& rhs) noexcept
+      -> simd
+  {
+    if constexpr (sizeof(T) == 1) return simd{_mm256_cmpeq_epi8(lhs.value_, rhs.value_)};
+    if constexpr (sizeof(T) == 2) return simd{_mm256_cmpeq_epi16(lhs.value_, rhs.value_)};
+    if constexpr (sizeof(T) == 4) return simd{_mm256_cmpeq_epi32(lhs.value_, rhs.value_)};
+    if constexpr (sizeof(T) == 8) return simd{_mm256_cmpeq_epi64(lhs.value_, rhs.value_)};
+  }
+
+  __attribute__((target("avx2"))) [[nodiscard]] friend auto operator&(const simd& lhs,
+                                                                      const simd& rhs) noexcept
+      -> simd
+  {
+    return simd{_mm256_and_si256(lhs.value_, rhs.value_)};
+  }
+
+  __attribute__((target("avx2"))) [[nodiscard]] friend auto operator|(const simd& lhs,
+                                                                      const simd& rhs) noexcept
+      -> simd
+  {
+    return simd{_mm256_or_si256(lhs.value_, rhs.value_)};
+  }
+
+  __attribute__((target("avx2"))) [[nodiscard]] auto to_bitmask() const noexcept -> std::uint64_t
+  {
+    if constexpr (sizeof(T) == 1) return static_cast<unsigned>(_mm256_movemask_epi8(value_));
+    if constexpr (sizeof(T) == 2) {
+      // Packing the two halves of the register keeps the lanes in order.
+      const __m128i bytes =
+          _mm_packs_epi16(_mm256_castsi256_si128(value_), _mm256_extracti128_si256(value_, 1));
+      return static_cast<unsigned>(_mm_movemask_epi8(bytes));
+    }
+    if constexpr (sizeof(T) == 4) {
+      return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(value_)));
+    }
+    if constexpr (sizeof(T) == 8) {
+      return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(value_)));
+    }
+  }
+
+  __attribute__((target("avx2"))) [[nodiscard]] auto shuffle(const simd& indices) const noexcept
+      -> simd
+  {
+    static_assert(sizeof(T) == 1, "Only bytes can be shuffled.");
+    return simd{_mm256_shuffle_epi8(value_, indices.value_)};
+  }
+
+ private:
+  __attribute__((target("avx2"))) explicit simd(__m256i value) noexcept : value_(value) {}
+
+  __m256i value_;
+};
+
+#endif
+
+/**
+ * @relates simd
+ * @brief The values of the lanes, the first lane first.
+ */
+template <typename T, std::size_t N, typename Abi>
+[[nodiscard]] auto to_array(const simd<T, N, Abi>& vector) noexcept -> std::array<T, N>
+{
+  std::array<T, N> lanes;
+  vector.store(lanes.data());
+  return lanes;
+}
+
+/**
+ * @relates simd
+ * @brief The sum of the lanes, wrapping around on overflow like the lanes do.
+ */
+template <typename T, std::size_t N, typename Abi>
+[[nodiscard]] auto reduce_add(const simd<T, N, Abi>& vector) noexcept -> T
+{
+  const auto lanes = to_array(vector);
+  return std::accumulate(lanes.begin(), lanes.end(), T{0},
+                         [](T lhs, T rhs) { return static_cast<T>(lhs + rhs); });
+}
+
+/**
+ * @relates simd
+ * @brief The smallest lane.
+ */
+template <typename T, std::size_t N, typename Abi>
+[[nodiscard]] auto reduce_min(const simd<T, N, Abi>& vector) noexcept -> T
+{
+  const auto lanes = to_array(vector);
+  return *std::min_element(lanes.begin(), lanes.end());
+}
+
+/**
+ * @relates simd
+ * @brief The largest lane.
+ */
+template <typename T, std::size_t N, typename Abi>
+[[nodiscard]] auto reduce_max(const simd<T, N, Abi>& vector) noexcept -> T
+{
+  const auto lanes = to_array(vector);
+  return *std::max_element(lanes.begin(), lanes.end());
+}
+
+/**
+ * @relates simd
+ * @brief The index of the lowest set bit of a non-zero bitmask, i.e. the first matching lane.
+ */
+[[nodiscard]] inline auto first_lane(std::uint64_t bitmask) noexcept -> std::size_t
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return static_cast<std::size_t>(__builtin_ctzll(bitmask));
+#else
+  std::size_t lane = 0;
+  for (; (bitmask & 1U) == 0; bitmask >>= 1U) {
+    ++lane;
+  }
+  return lane;
+#endif
+}
+
+}  // namespace bricks
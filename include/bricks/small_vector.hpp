@@ -0,0 +1,330 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "type_traits.hpp"
+
+namespace bricks {
+
+/**
+ * @brief A vector that stores up to `N` elements inline, without allocating.
+ *
+ * Only when it grows beyond `N` elements it moves them to the heap, like `std::vector`. Elements
+ * of trivially relocatable types, see `is_trivially_relocatable`, are moved between buffers with
+ * a single `memcpy` instead of one move construction and destruction per element.
+ *
+ * Unlike `std::vector`, moving a small_vector that stores its elements inline moves the elements,
+ * so it invalidates iterators.
+ *
+ * Example:
+ * @snippet small_vector_test.cpp small_vector-example
+ *
+ * @tparam T The type of the elements.
+ * @tparam N The number of elements stored inline.
+ */
+template <typename T, std::size_t N>
+class small_vector {
+  static_assert(N > 0, "A small_vector needs inline capacity, use std::vector instead.");
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = T&;
+  using const_reference = const T&;
+  using pointer = T*;
+  using const_pointer = const T*;
+  using iterator = T*;
+  using const_iterator = const T*;
+
+  small_vector() noexcept = default;
+
+  small_vector(std::initializer_list<T> init) : small_vector(init.begin(), init.end()) {}
+
+  /**
+   * @brief Copy a range of elements.
+   *
+   * Reserves once for random access iterators. Pointers to trivially copyable elements, e.g. when
+   * copying another small_vector, are copied with a single `memcpy`.
+   */
+  template <typename InputIt, typename std::enable_if_t<is_iterator_v<InputIt>, bool> = true>
+  small_vector(InputIt first, InputIt last)
+  {
+    if constexpr (is_random_access_iterator_v<InputIt>) {
+      reserve(static_cast<size_type>(last - first));
+    }
+    if constexpr (std::is_pointer_v<InputIt> &&
+                  std::is_same_v<std::remove_cv_t<std::remove_pointer_t<InputIt>>, T> &&
+                  std::is_trivially_copyable_v<T>) {
+      const auto count = static_cast<size_type>(last - first);
+      if (count != 0) std::memcpy(static_cast<void*>(data_), first, count * sizeof(T));
+      size_ = count;
+    } else {
+      for (; first != last; ++first) {
+        emplace_back(*first);
+      }
+    }
+  }
+
+  small_vector(const small_vector& other) : small_vector(other.begin(), other.end()) {}
+
+  small_vector(small_vector&& other) noexcept(is_trivially_relocatable_v<T> ||
+                                              std::is_nothrow_move_constructible_v<T>)
+  {
+    take(std::move(other));
+  }
+
+  auto operator=(const small_vector& other) -> small_vector&
+  {
+    if (this != &other) {
+      clear();
+      reserve(other.size());
+      std::uninitialized_copy(other.begin(), other.end(), data_);
+      size_ = other.size_;
+    }
+    return *this;
+  }
+
+  auto operator=(small_vector&& other) noexcept(is_trivially_relocatable_v<T> ||
+                                                std::is_nothrow_move_constructible_v<T>)
+      -> small_vector&
+  {
+    if (this != &other) {
+      clear();
+      release();
+      take(std::move(other));
+    }
+    return *this;
+  }
+
+  ~small_vector()
+  {
+    clear();
+    release();
+  }
+
+  /** @brief The number of elements. */
+  [[nodiscard]] auto size() const noexcept -> size_type { return size_; }
+  /** @brief The number of elements that fit without allocating. */
+  [[nodiscard]] auto capacity() const noexcept -> size_type { return capacity_; }
+  /** @brief Whether there are no elements. */
+  [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+  /** @brief Whether the elements are stored inline. */
+  [[nodiscard]] auto is_inline() const noexcept -> bool { return data_ == inline_data(); }
+  /** @brief The number of elements stored inline. */
+  [[nodiscard]] static constexpr auto inline_capacity() noexcept -> size_type { return N; }
+
+  [[nodiscard]] auto data() noexcept -> T* { return data_; }
+  [[nodiscard]] auto data() const noexcept -> const T* { return data_; }
+
+  [[nodiscard]] auto begin() noexcept -> iterator { return data_; }
+  [[nodiscard]] auto begin() const noexcept -> const_iterator { return data_; }
+  [[nodiscard]] auto end() noexcept -> iterator { return data_ + size_; }
+  [[nodiscard]] auto end() const noexcept -> const_iterator { return data_ + size_; }
+
+  [[nodiscard]] auto operator[](size_type pos) noexcept -> reference { return data_[pos]; }
+  [[nodiscard]] auto operator[](size_type pos) const noexcept -> const_reference
+  {
+    return data_[pos];
+  }
+
+  /**
+   * @brief Access an element with bounds checking.
+   *
+   * Throws `std::out_of_range` if `pos` is not less than `size()`.
+   */
+  [[nodiscard]] auto at(size_type pos) -> reference
+  {
+    if (pos >= size_) throw std::out_of_range{"small_vector::at"};
+    return data_[pos];
+  }
+  [[nodiscard]] auto at(size_type pos) const -> const_reference
+  {
+    if (pos >= size_) throw std::out_of_range{"small_vector::at"};
+    return data_[pos];
+  }
+
+  [[nodiscard]] auto front() noexcept -> reference { return data_[0]; }
+  [[nodiscard]] auto front() const noexcept -> const_reference { return data_[0]; }
+  [[nodiscard]] auto back() noexcept -> reference { return data_[size_ - 1]; }
+  [[nodiscard]] auto back() const noexcept -> const_reference { return data_[size_ - 1]; }
+
+  /**
+   * @brief Make room for at least `new_capacity` elements.
+   */
+  void reserve(size_type new_capacity)
+  {
+    if (new_capacity <= capacity_) return;
+    T* new_data = allocate(new_capacity);
+    relocate_or_free(new_data, new_capacity);
+  }
+
+  /**
+   * @brief Construct an element at the end.
+   *
+   * The arguments may refer to elements of the vector itself.
+   *
+   * @return reference The new element.
+   */
+  template <typename... Args>
+  auto emplace_back(Args&&... args) -> reference
+  {
+    if (size_ < capacity_) {
+      ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+    } else {
+      // The new element is constructed before the old ones are moved, in case it refers to one.
+      const auto new_capacity = std::max<size_type>(2 * capacity_, size_ + 1);
+      T* new_data = allocate(new_capacity);
+      try {
+        ::new (static_cast<void*>(new_data + size_)) T(std::forward<Args>(args)...);
+      } catch (...) {
+        deallocate(new_data, new_capacity);
+        throw;
+      }
+      try {
+        relocate(data_, size_, new_data);
+      } catch (...) {
+        // The new element lives in the new buffer, so it is destroyed before the buffer is freed.
+        new_data[size_].~T();
+        deallocate(new_data, new_capacity);
+        throw;
+      }
+      adopt(new_data, new_capacity);
+    }
+    return data_[size_++];
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /** @brief Destroy the last element. */
+  void pop_back() noexcept { data_[--size_].~T(); }
+
+  /**
+   * @brief Change the number of elements, value initializing new ones.
+   */
+  void resize(size_type count)
+  {
+    reserve(count);
+    while (size_ < count) {
+      ::new (static_cast<void*>(data_ + size_)) T();
+      ++size_;
+    }
+    while (size_ > count) {
+      pop_back();
+    }
+  }
+
+  /** @brief Destroy all elements, keeping the capacity. */
+  void clear() noexcept
+  {
+    std::destroy(data_, data_ + size_);
+    size_ = 0;
+  }
+
+  [[nodiscard]] friend auto operator==(const small_vector& lhs, const small_vector& rhs) -> bool
+  {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+  [[nodiscard]] friend auto operator!=(const small_vector& lhs, const small_vector& rhs) -> bool
+  {
+    return !(lhs == rhs);
+  }
+
+ private:
+  // No `std::launder`, the storage often holds no element, e.g. when empty. The elements are only
+  // accessed through `data_`, which points to them from their construction on.
+  [[nodiscard]] auto inline_data() noexcept -> T*
+  {
+    return reinterpret_cast<T*>(storage_);  // NOLINT
+  }
+  [[nodiscard]] auto inline_data() const noexcept -> const T*
+  {
+    return reinterpret_cast<const T*>(storage_);  // NOLINT
+  }
+
+  static auto allocate(size_type count) -> T* { return std::allocator<T>{}.allocate(count); }
+  static void deallocate(T* data, size_type count) noexcept
+  {
+    std::allocator<T>{}.deallocate(data, count);
+  }
+
+  /**
+   * @brief Move `count` elements from `from` to the uninitialized `to` and destroy the originals.
+   */
+  static void relocate(T* from, size_type count, T* to)
+  {
+    if constexpr (is_trivially_relocatable_v<T>) {
+      if (count != 0) {
+        std::memcpy(static_cast<void*>(to), static_cast<const void*>(from), count * sizeof(T));
+      }
+    } else {
+      if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        std::uninitialized_move(from, from + count, to);
+      } else {
+        std::uninitialized_copy(from, from + count, to);
+      }
+      std::destroy(from, from + count);
+    }
+  }
+
+  /**
+   * @brief Move the elements to a new heap buffer, which is freed again if that throws.
+   */
+  void relocate_or_free(T* new_data, size_type new_capacity)
+  {
+    try {
+      relocate(data_, size_, new_data);
+    } catch (...) {
+      deallocate(new_data, new_capacity);
+      throw;
+    }
+    adopt(new_data, new_capacity);
+  }
+
+  /** @brief Free the old buffer, if on the heap, and switch to the relocated elements. */
+  void adopt(T* new_data, size_type new_capacity) noexcept
+  {
+    release();
+    data_ = new_data;
+    capacity_ = new_capacity;
+  }
+
+  /** @brief Free the heap buffer, if any, and go back to the inline one. */
+  void release() noexcept
+  {
+    if (!is_inline()) deallocate(data_, capacity_);
+    data_ = inline_data();
+    capacity_ = N;
+  }
+
+  /** @brief Take over the elements of an empty vector's heap buffer or inline elements. */
+  void take(small_vector&& other)
+  {
+    if (other.is_inline()) {
+      relocate(other.data_, other.size_, data_);
+    } else {
+      data_ = other.data_;
+      capacity_ = other.capacity_;
+      other.data_ = other.inline_data();
+      other.capacity_ = N;
+    }
+    size_ = other.size_;
+    other.size_ = 0;
+  }
+
+  alignas(T) unsigned char storage_[N * sizeof(T)];  // NOLINT
+  T* data_{inline_data()};
+  size_type size_{0};
+  size_type capacity_{N};
+};
+
+}  // namespace bricks
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace bricks {
+
+namespace detail {
+
+/**
+ * @brief The assumed size of a cache line. Instances padded to it do not share lines.
+ */
+inline constexpr std::size_t cache_line_size = 64;
+
+/**
+ * @brief The ids of the `thread_specific`s that are alive.
+ */
+class thread_specific_registry {
+ public:
+  [[nodiscard]] static auto global() -> thread_specific_registry&
+  {
+    static thread_specific_registry registry;
+    return registry;
+  }
+
+  /** @brief A new id, unique for the lifetime of the program. */
+  [[nodiscard]] auto add() -> std::uint64_t
+  {
+    const std::lock_guard lock{mutex_};
+    const auto id = next_++;
+    alive_.insert(id);
+    return id;
+  }
+
+  void remove(std::uint64_t id)
+  {
+    const std::lock_guard lock{mutex_};
+    alive_.erase(id);
+  }
+
+  /** @brief Erase the entries of `thread_specific`s that were destroyed. */
+  template <typename Map>
+  void prune(Map& slots)
+  {
+    const std::lock_guard lock{mutex_};
+    for (auto it = slots.begin(); it != slots.end();) {
+      it = alive_.count(it->first) == 0 ? slots.erase(it) : std::next(it);
+    }
+  }
+
+ private:
+  std::mutex mutex_;
+  std::uint64_t next_{0};
+  std::unordered_set<std::uint64_t> alive_;
+};
+
+/**
+ * @brief The instance of a thread, and the generation of its `thread_specific` it belongs to.
+ */
+struct thread_specific_entry {
+  std::uint64_t generation;
+  void* slot;
+};
+
+/**
+ * @brief The instances of a thread, by the id of the `thread_specific` they belong to.
+ *
+ * A cleared `thread_specific` has a new generation, so the entries of the old one are overwritten.
+ * Entries of destroyed ones are pruned whenever the map has doubled in size, so it stays
+ * proportional to the number of `thread_specific`s alive.
+ */
+struct thread_specific_slots {
+  static constexpr std::size_t min_prune_size = 16;
+
+  [[nodiscard]] static auto local() -> thread_specific_slots&
+  {
+    thread_local thread_specific_slots slots;
+    return slots;
+  }
+
+  /** @brief Add or overwrite an entry, pruning first if the map has grown enough. */
+  void assign(std::uint64_t id, thread_specific_entry entry)
+  {
+    if (entries.size() >= prune_size && entries.count(id) == 0) {
+      thread_specific_registry::global().prune(entries);
+      prune_size = std::max(min_prune_size, 2 * entries.size());
+    }
+    entries[id] = entry;
+  }
+
+  std::unordered_map<std::uint64_t, thread_specific_entry> entries;
+  std::size_t prune_size{min_prune_size};
+};
+
+template <typename Iter, typename Value>
+class thread_specific_iterator {
+ public:
+  using difference_type = std::ptrdiff_t;
+  using value_type = std::remove_const_t<Value>;
+  using pointer = Value*;
+  using reference = Value&;
+  using iterator_category = std::forward_iterator_tag;
+
+  explicit thread_specific_iterator(Iter iter) : iter_{iter} {}
+
+  auto operator++() -> thread_specific_iterator&
+  {
+    ++iter_;
+    return *this;
+  }
+
+  auto operator++(int) -> thread_specific_iterator
+  {
+    auto tmp = *this;
+    ++*this;
+    return tmp;
+  }
+
+  auto operator==(const thread_specific_iterator& other) const -> bool
+  {
+    return iter_ == other.iter_;
+  }
+  auto operator!=(const thread_specific_iterator& other) const -> bool { return !(*this == other); }
+
+  auto operator*() const -> reference { return iter_->value; }
+  auto operator->() const -> pointer { return &iter_->value; }
+
+ private:
+  Iter iter_;
+};
+
+}  // namespace detail
+
+/**
+ * @brief One lazily constructed instance of `T` per thread, which can be enumerated.
+ *
+ * Each thread gets its own instance on its first call of `local()`, later calls return the same
+ * instance without locking. The instances are padded to separate cache lines, so threads updating
+ * their own instance do not slow each other down. Unlike `thread_local` variables, all instances
+ * can be iterated, e.g. with `enumerate`, or reduced with `combine`, for example to sum per thread
+ * partial results instead of updating a shared total in a `mutex`.
+ *
+ * Instances outlive the threads that created them, until the `thread_specific` is cleared or
+ * destroyed. Iterating, `combine`, `size` and `clear` do not synchronize with threads using their
+ * instances, so call them after the threads are done, e.g. joined.
+ *
+ * Example:
+ * @snippet thread_specific_test.cpp thread_specific-example
+ *
+ * @tparam T The type of the instances.
+ */
+template <typename T>
+class thread_specific {
+  struct alignas(detail::cache_line_size) slot {
+    explicit slot(T init) : value{std::move(init)} {}
+
+    T value;
+  };
+
+ public:
+  using value_type = T;
+  using size_type = std::size_t;
+  using iterator = detail::thread_specific_iterator<typename std::deque<slot>::iterator, T>;
+  using const_iterator =
+      detail::thread_specific_iterator<typename std::deque<slot>::const_iterator, const T>;
+
+  /**
+   * @brief Create the instances value initialized.
+   */
+  thread_specific() : factory_{[] { return T{}; }} {}
+
+  /**
+   * @brief Create the instances with a factory, called once per thread.
+   *
+   * @param factory Returns the initial value of an instance.
+   */
+  explicit thread_specific(std::function<T()> factory) : factory_{std::move(factory)} {}
+
+  thread_specific(const thread_specific&) = delete;
+  thread_specific(thread_specific&&) = delete;
+  auto operator=(const thread_specific&) -> thread_specific& = delete;
+  auto operator=(thread_specific&&) -> thread_specific& = delete;
+  ~thread_specific() { detail::thread_specific_registry::global().remove(id_); }
+
+  /**
+   * @brief The instance of the calling thread, constructed on the first call.
+   *
+   * Only the first call of each thread takes a lock.
+   *
+   * @return T& The instance of the calling thread.
+   */
+  [[nodiscard]] auto local() -> T&
+  {
+    auto& slots = detail::thread_specific_slots::local();
+    if (const auto found = slots.entries.find(id_);
+        found != slots.entries.end() && found->second.generation == generation_) {
+      return static_cast<slot*>(found->second.slot)->value;
+    }
+
+    const std::lock_guard lock{mutex_};
+    auto& created = slots_.emplace_back(factory_());
+    slots.assign(id_, {generation_, &created});
+    return created.value;
+  }
+
+  /**
+   * @brief The number of instances, i.e. the number of threads that called `local()`.
+   */
+  [[nodiscard]] auto size() const -> size_type
+  {
+    const std::lock_guard lock{mutex_};
+    return slots_.size();
+  }
+
+  /** @brief Whether no thread called `local()` yet. */
+  [[nodiscard]] auto empty() const -> bool { return size() == 0; }
+
+  /**
+   * @brief Reduce the instances, like `std::accumulate`.
+   *
+   * @param init The initial value.
+   * @param fn Combines the result so far with the next instance.
+   * @return T The result, `init` if there are no instances.
+   */
+  template <typename BinaryOp>
+  [[nodiscard]] auto combine(T init, BinaryOp fn) const -> T
+  {
+    const std::lock_guard lock{mutex_};
+    for (const auto& instance : slots_) {
+      init = fn(std::move(init), instance.value);
+    }
+    return init;
+  }
+
+  /**
+   * @brief Reduce the instances, starting with a value initialized `T`.
+   *
+   * Example:
+   * @snippet thread_specific_test.cpp thread_specific-example
+   */
+  template <typename BinaryOp>
+  [[nodiscard]] auto combine(BinaryOp fn) const -> T
+  {
+    return combine(T{}, std::move(fn));
+  }
+
+  /**
+   * @brief Destroy all instances, threads get new ones on their next call of `local()`.
+   */
+  void clear()
+  {
+    const std::lock_guard lock{mutex_};
+    slots_.clear();
+    ++generation_;
+  }
+
+  [[nodiscard]] auto begin() -> iterator { return iterator{slots_.begin()}; }
+  [[nodiscard]] auto begin() const -> const_iterator { return const_iterator{slots_.begin()}; }
+  [[nodiscard]] auto end() -> iterator { return iterator{slots_.end()}; }
+  [[nodiscard]] auto end() const -> const_iterator { return const_iterator{slots_.end()}; }
+
+ private:
+  std::function<T()> factory_;
+  std::uint64_t id_{detail::thread_specific_registry::global().add()};
+  std::uint64_t generation_{0};
+  mutable std::mutex mutex_;
+  // A deque never moves its elements when growing, so the threads' pointers stay valid.
+  std::deque<slot> slots_;
+};
+
+}  // namespace bricks
@@ -4,6 +4,8 @@
 #include <future>
 #include <thread>
 
+#include "trace.hpp"
+
 namespace bricks {
 
 /**
@@ -15,24 +17,44 @@ namespace bricks {
  * completion token will be ready immediately. Will abort all outstanding timers when it is
  * destroyed.
  *
+ * The clock used for the deadlines is a template parameter. The generic template only fits clocks
+ * with a static `now()`, like the standard clocks. For deterministic tests use
+ * `basic_timer<virtual_clock>` (see `virtual_clock.hpp`), which fires when the clock is advanced
+ * instead of after real time passed. Both can be constructed from a `Clock&`, so code that is
+ * generic over the clock does not need to know which one it gets.
+ *
  * Example:
  * @snippet timer_test.cpp timer-example
+ *
+ * @tparam Clock The clock the timer's deadlines are measured with.
  */
-class timer {
+template <typename Clock>
+class basic_timer {
  public:
   /** @brief Default constructor. */
-  timer() noexcept {};  // NOLINT (can't use default, since std::promise does not have a noexcept
-                        // ctor)
+  basic_timer() noexcept {};  // NOLINT (can't use default, since std::promise does not have a
+                              // noexcept ctor)
+
+  /**
+   * @brief Construct a timer measuring its deadlines with `clock`.
+   *
+   * @details
+   * Standard clocks have a static `now()`, so the object itself is not used. This gives
+   * `basic_timer<virtual_clock>` and the generic template the same constructor signature.
+   *
+   * @param clock The clock to measure deadlines with.
+   */
+  explicit basic_timer(Clock& /* clock */) noexcept : basic_timer() {}
 
   /** @brief A timer cannot be copied. */
-  timer(const timer&) = delete;
+  basic_timer(const basic_timer&) = delete;
   /** @brief A timer cannot be copied. */
-  auto operator=(const timer&) -> timer& = delete;
+  auto operator=(const basic_timer&) -> basic_timer& = delete;
 
   /** @brief Move constructor. */
-  timer(timer&&) = default;
+  basic_timer(basic_timer&&) = default;
   /** @brief Move assignment operator. */
-  auto operator=(timer&&) -> timer& = default;
+  auto operator=(basic_timer&&) -> basic_timer& = default;
 
   /**
    * @brief Destroy the timer object.
@@ -40,7 +62,7 @@ class timer {
    * @details
    * Will abort all outstanding timers.
    */
-  ~timer() { abort(); };
+  ~basic_timer() { abort(); };
 
   /**
    * @brief A completion token that can be used to wait for the timer to complete.
@@ -64,16 +86,18 @@ class timer {
    *
    * @param duration The duration to wait before completing the token.
    *
-   * @return A timer::completion_token that will be completed when the timer expires.
+   * @return A completion_token that will be completed when the timer expires.
    */
   template <typename Rep = int64_t, typename Period = std::ratio<1>>
   [[nodiscard]] auto start(const std::chrono::duration<Rep, Period>& duration =
                                std::chrono::duration<Rep, Period>{}) const noexcept
       -> completion_token
   {
-    return std::async(std::launch::async, [abortion_future = abortion_future_, duration]() {
-      abortion_future.wait_for(duration);
-    });
+    return std::async(std::launch::async,
+                      [abortion_future = abortion_future_, deadline = Clock::now() + duration]() {
+                        BRICKS_TRACE_SCOPE("bricks::timer");
+                        abortion_future.wait_until(deadline);
+                      });
   }
 
   /**
@@ -96,4 +120,12 @@ class timer {
   std::shared_future<void> abortion_future_{abortion_promise_.get_future()};
 };
 
+/**
+ * @brief A timer measuring its deadlines with the steady clock.
+ *
+ * Example:
+ * @snippet timer_test.cpp timer-example
+ */
+using timer = basic_timer<std::chrono::steady_clock>;
+
 }  // namespace bricks
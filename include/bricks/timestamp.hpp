@@ -0,0 +1,536 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#include "detail/digits.hpp"
+#include "detail/swar.hpp"
+#include "fixed_point.hpp"
+#include "result.hpp"
+
+namespace bricks {
+
+/**
+ * @brief A point in time of the system clock, with the given precision.
+ */
+template <typename Duration>
+using sys_time = std::chrono::time_point<std::chrono::system_clock, Duration>;
+
+namespace detail {
+
+template <typename T>
+struct is_sys_time : std::false_type {
+};
+
+template <typename Duration>
+struct is_sys_time<sys_time<Duration>> : std::true_type {
+};
+
+template <typename T>
+inline constexpr bool is_sys_time_v = is_sys_time<T>::value;
+
+/**
+ * @brief Days since 1970-01-01 of a date in the proleptic Gregorian calendar.
+ *
+ * Howard Hinnant's `days_from_civil`.
+ */
+constexpr auto days_from_civil(std::int64_t year, unsigned month, unsigned day) noexcept
+    -> std::int64_t
+{
+  year -= month <= 2 ? 1 : 0;
+  const auto era = (year >= 0 ? year : year - 399) / 400;
+  const auto year_of_era = static_cast<unsigned>(year - era * 400);
+  const auto day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  const auto day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+  return era * 146097 + static_cast<std::int64_t>(day_of_era) - 719468;
+}
+
+struct civil_date {
+  std::int64_t year;
+  unsigned month;
+  unsigned day;
+};
+
+/**
+ * @brief The date of a number of days since 1970-01-01, the inverse of `days_from_civil`.
+ */
+constexpr auto civil_from_days(std::int64_t days) noexcept -> civil_date
+{
+  days += 719468;
+  const auto era = (days >= 0 ? days : days - 146096) / 146097;
+  const auto day_of_era = static_cast<unsigned>(days - era * 146097);
+  const auto year_of_era =
+      (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+  const auto day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+  const auto shifted_month = (5 * day_of_year + 2) / 153;
+  const auto day = day_of_year - (153 * shifted_month + 2) / 5 + 1;
+  const auto month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+  return {static_cast<std::int64_t>(year_of_era) + era * 400 + (month <= 2 ? 1 : 0), month, day};
+}
+
+constexpr auto days_in_month(std::int64_t year, unsigned month) noexcept -> unsigned
+{
+  if (month != 2) return month == 4 || month == 6 || month == 9 || month == 11 ? 30 : 31;
+  const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+  return leap ? 29 : 28;
+}
+
+/**
+ * @brief Turn the separators of a word of eight characters into `'0'`, so that it is a word of
+ * eight digits if the other characters are.
+ *
+ * @param separators A mask with `0xff` in the bytes of the separators.
+ * @param expected The separators at their positions.
+ */
+constexpr auto replace_separators(std::uint64_t word, std::uint64_t separators,
+                                  std::uint64_t expected) noexcept -> std::uint64_t
+{
+  if ((word & separators) != expected) return 0;
+  return (word & ~separators) | (0x3030303030303030U & separators);
+}
+
+/**
+ * @brief Combine each digit with its successor, byte `i` then holds `10 * digit[i] + digit[i + 1]`.
+ */
+constexpr auto digit_pairs_of(std::uint64_t digits) noexcept -> std::uint64_t
+{
+  digits -= 0x3030303030303030U;
+  return digits * 10U + (digits >> 8U);
+}
+
+constexpr auto byte_at(std::uint64_t word, unsigned index) noexcept -> unsigned
+{
+  return static_cast<unsigned>((word >> (8U * index)) & 0xffU);
+}
+
+/**
+ * @brief Parse `YYYY-MM-DD` into days since the epoch.
+ */
+inline auto parse_date(const char* chars) noexcept -> result<std::int64_t, std::errc>
+{
+  // "YYYY-MM-"
+  constexpr std::uint64_t separators = 0xff00'00ff'0000'0000U;
+  constexpr std::uint64_t dashes = 0x2d00'002d'0000'0000U;
+  const auto word = replace_separators(load_eight_chars(chars), separators, dashes);
+  if (!is_eight_digits(word)) return std::errc::invalid_argument;
+  if (chars[8] < '0' || chars[8] > '9' || chars[9] < '0' || chars[9] > '9') {
+    return std::errc::invalid_argument;
+  }
+
+  const auto pairs = digit_pairs_of(word);
+  const auto year = std::int64_t{byte_at(pairs, 0)} * 100 + byte_at(pairs, 2);
+  const auto month = byte_at(pairs, 5);
+  const auto day = static_cast<unsigned>((chars[8] - '0') * 10 + (chars[9] - '0'));
+  if (month < 1 || month > 12 || day < 1 || day > days_in_month(year, month)) {
+    return std::errc::invalid_argument;
+  }
+  return days_from_civil(year, month, day);
+}
+
+/**
+ * @brief Parse `HH:MM:SS` into seconds since midnight, allowing a leap second.
+ */
+inline auto parse_time_of_day(const char* chars) noexcept -> result<std::int64_t, std::errc>
+{
+  constexpr std::uint64_t separators = 0x0000'ff00'00ff'0000U;
+  constexpr std::uint64_t colons = 0x0000'3a00'003a'0000U;
+  const auto word = replace_separators(load_eight_chars(chars), separators, colons);
+  if (!is_eight_digits(word)) return std::errc::invalid_argument;
+
+  const auto pairs = digit_pairs_of(word);
+  const auto hours = byte_at(pairs, 0);
+  const auto minutes = byte_at(pairs, 3);
+  const auto seconds = byte_at(pairs, 6);
+  if (hours > 23 || minutes > 59 || seconds > 60) return std::errc::invalid_argument;
+  return std::int64_t{hours} * 3600 + minutes * 60 + seconds;
+}
+
+/**
+ * @brief The last parsed date, reused if the next timestamp is on the same day.
+ */
+struct date_cache {
+  std::array<char, 10> chars{};
+  std::int64_t days{0};
+  bool valid{false};
+};
+
+struct timestamp_parts {
+  std::int64_t seconds;
+  std::int64_t nanoseconds;
+};
+
+constexpr auto is_digit_char(char c) noexcept -> bool { return c >= '0' && c <= '9'; }
+
+inline auto parse_offset(std::string_view str) noexcept -> result<std::int64_t, std::errc>
+{
+  if (str == "Z" || str == "z" || str.empty()) return std::int64_t{0};
+  if (str[0] != '+' && str[0] != '-') return std::errc::invalid_argument;
+
+  const auto two_digits = [](const char* chars) -> int {
+    if (!is_digit_char(chars[0]) || !is_digit_char(chars[1])) return -1;
+    return (chars[0] - '0') * 10 + (chars[1] - '0');
+  };
+
+  int hours = -1;
+  int minutes = 0;
+  if (str.size() == 3) {
+    hours = two_digits(str.data() + 1);
+  } else if (str.size() == 5) {
+    hours = two_digits(str.data() + 1);
+    minutes = two_digits(str.data() + 3);
+  } else if (str.size() == 6 && str[3] == ':') {
+    hours = two_digits(str.data() + 1);
+    minutes = two_digits(str.data() + 4);
+  }
+  if (hours < 0 || hours > 23 || minutes < 0 || minutes > 59) return std::errc::invalid_argument;
+
+  const auto offset = std::int64_t{hours} * 3600 + minutes * 60;
+  return str[0] == '-' ? -offset : offset;
+}
+
+inline auto parse_iso_timestamp(std::string_view str, date_cache* cache) noexcept
+    -> result<timestamp_parts, std::errc>
+{
+  // "YYYY-MM-DDTHH:MM:SS"
+  constexpr std::size_t min_size = 19;
+  if (str.size() < min_size) return std::errc::invalid_argument;
+  if (str[10] != 'T' && str[10] != 't' && str[10] != ' ') return std::errc::invalid_argument;
+
+  std::int64_t days = 0;
+  if (cache != nullptr && cache->valid &&
+      std::memcmp(cache->chars.data(), str.data(), cache->chars.size()) == 0) {
+    days = cache->days;
+  } else {
+    const auto date = parse_date(str.data());
+    if (date.is_error()) return date.unwrap_error();
+    days = date.unwrap_or(0);
+    if (cache != nullptr) {
+      std::memcpy(cache->chars.data(), str.data(), cache->chars.size());
+      cache->days = days;
+      cache->valid = true;
+    }
+  }
+
+  const auto time_of_day = parse_time_of_day(str.data() + 11);
+  if (time_of_day.is_error()) return time_of_day.unwrap_error();
+
+  std::size_t pos = min_size;
+  std::int64_t nanoseconds = 0;
+  if (pos < str.size() && (str[pos] == '.' || str[pos] == ',')) {
+    const auto start = ++pos;
+    for (; pos < str.size() && is_digit_char(str[pos]); ++pos) {
+      // Digits past nanoseconds are truncated.
+      if (pos - start < 9) nanoseconds = nanoseconds * 10 + (str[pos] - '0');
+    }
+    if (pos == start) return std::errc::invalid_argument;
+    const auto digits = pos - start < 9 ? pos - start : 9;
+    nanoseconds *= static_cast<std::int64_t>(powers_of_ten[9 - digits]);
+  }
+
+  const auto offset = parse_offset(str.substr(pos));
+  if (offset.is_error()) return offset.unwrap_error();
+
+  return timestamp_parts{days * 86400 + time_of_day.unwrap_or(0) - offset.unwrap_or(0),
+                         nanoseconds};
+}
+
+template <typename Duration>
+auto to_sys_time(const timestamp_parts& parts) noexcept -> result<sys_time<Duration>, std::errc>
+{
+  using std::chrono::duration_cast;
+  if constexpr (std::ratio_greater_equal_v<typename Duration::period, std::ratio<1>>) {
+    // Durations of whole seconds can hold more seconds than the parts, so the range is checked in
+    // ticks. The fraction never reaches the next tick, so flooring the seconds floors the sum.
+    using ticks = std::chrono::duration<std::int64_t, typename Duration::period>;
+    const auto count = std::chrono::floor<ticks>(std::chrono::seconds{parts.seconds}).count();
+    if (count > static_cast<std::int64_t>(Duration::max().count()) ||
+        count < static_cast<std::int64_t>(Duration::min().count())) {
+      return std::errc::result_out_of_range;
+    }
+    return sys_time<Duration>{Duration{static_cast<typename Duration::rep>(count)}};
+  } else {
+    constexpr auto max_seconds = duration_cast<std::chrono::seconds>(Duration::max()).count() - 1;
+    constexpr auto min_seconds = duration_cast<std::chrono::seconds>(Duration::min()).count() + 1;
+    if (parts.seconds > max_seconds || parts.seconds < min_seconds) {
+      return std::errc::result_out_of_range;
+    }
+    return sys_time<Duration>{
+        duration_cast<Duration>(std::chrono::seconds{parts.seconds}) +
+        duration_cast<Duration>(std::chrono::nanoseconds{parts.nanoseconds})};
+  }
+}
+
+/**
+ * @brief The number of fractional digits needed to show every tick of `Duration`.
+ */
+template <typename Duration>
+constexpr auto fraction_digits() noexcept -> std::size_t
+{
+  using period = typename Duration::period;
+  if constexpr (period::num != 1 || period::den == 1) {
+    return 0;
+  } else {
+    std::size_t digits = 0;
+    while (digits < 18 && powers_of_ten[digits] < static_cast<std::uint64_t>(period::den)) {
+      ++digits;
+    }
+    return digits;
+  }
+}
+
+template <std::size_t Digits>
+using fraction_duration =
+    std::chrono::duration<std::int64_t, std::ratio<1, static_cast<std::intmax_t>(
+                                                          make_powers_of_ten()[Digits])>>;
+
+inline auto write_two_digits(char* out, unsigned value) noexcept -> void
+{
+  out[0] = digit_pairs[2 * value];
+  out[1] = digit_pairs[2 * value + 1];
+}
+
+/**
+ * @brief Write `YYYY-MM-DDT` for a number of days since the epoch, years must be within 0-9999.
+ */
+inline auto write_date(char* out, std::int64_t days) noexcept -> bool
+{
+  const auto date = civil_from_days(days);
+  if (date.year < 0 || date.year > 9999) return false;
+  const auto year = static_cast<unsigned>(date.year);
+  write_two_digits(out, year / 100);
+  write_two_digits(out + 2, year % 100);
+  out[4] = '-';
+  write_two_digits(out + 5, date.month);
+  out[7] = '-';
+  write_two_digits(out + 8, date.day);
+  out[10] = 'T';
+  return true;
+}
+
+/**
+ * @brief The number of characters of a formatted timestamp of the given precision.
+ */
+template <typename Duration>
+constexpr auto timestamp_size() noexcept -> std::size_t
+{
+  constexpr auto digits = fraction_digits<Duration>();
+  return 20 + (digits == 0 ? 0 : digits + 1);
+}
+
+/**
+ * @brief Format a timestamp, reusing the date of the cache if it is the same day.
+ */
+template <typename Duration>
+auto format_timestamp(const sys_time<Duration>& time, char* first, char* last,
+                      std::int64_t* cached_day, char* cached_date) noexcept
+    -> result<char*, std::errc>
+{
+  using std::chrono::duration_cast;
+  constexpr auto digits = fraction_digits<Duration>();
+  if (static_cast<std::size_t>(last - first) < timestamp_size<Duration>()) {
+    return std::errc::value_too_large;
+  }
+
+  const auto since_epoch = time.time_since_epoch();
+  auto seconds = duration_cast<std::chrono::seconds>(since_epoch);
+  if (seconds > since_epoch) seconds -= std::chrono::seconds{1};
+  auto days = seconds.count() / 86400;
+  auto second_of_day = seconds.count() % 86400;
+  if (second_of_day < 0) {
+    second_of_day += 86400;
+    --days;
+  }
+
+  if (cached_day != nullptr && *cached_day == days) {
+    std::memcpy(first, cached_date, 11);
+  } else {
+    if (!write_date(first, days)) return std::errc::value_too_large;
+    if (cached_day != nullptr) {
+      *cached_day = days;
+      std::memcpy(cached_date, first, 11);
+    }
+  }
+
+  char* out = first + 11;
+  const auto time_of_day = static_cast<unsigned>(second_of_day);
+  write_two_digits(out, time_of_day / 3600);
+  out[2] = ':';
+  write_two_digits(out + 3, time_of_day / 60 % 60);
+  out[5] = ':';
+  write_two_digits(out + 6, time_of_day % 60);
+  out += 8;
+
+  if constexpr (digits > 0) {
+    const auto fraction = duration_cast<fraction_duration<digits>>(since_epoch - seconds).count();
+    *out++ = '.';
+    const auto fraction_size = count_digits(static_cast<std::uint64_t>(fraction));
+    for (std::size_t i = fraction_size; i < digits; ++i) {
+      *out++ = '0';
+    }
+    write_digits_backwards(out + fraction_size, static_cast<std::uint64_t>(fraction));
+    out += fraction_size;
+  }
+  *out++ = 'Z';
+  return out;
+}
+
+}  // namespace detail
+
+/**
+ * @brief Exceptionlessly parse an ISO-8601 timestamp.
+ *
+ * The accepted format is `YYYY-MM-DDTHH:MM:SS`, followed by an optional fraction of a second and an
+ * optional offset: `Z`, `+HH:MM`, `+HHMM` or `+HH`. Timestamps without an offset are taken to be
+ * UTC. `t` or a space may separate date and time. Fractions are truncated to the precision of
+ * `Duration`.
+ *
+ * The fixed width fields are validated and converted eight characters at a time.
+ *
+ * Example:
+ * @snippet timestamp_test.cpp parse_timestamp-example
+ *
+ * @tparam Duration The precision of the returned time point.
+ * @param str The string to parse.
+ * @return result<sys_time<Duration>, std::errc> The point in time, `std::errc::invalid_argument`
+ *         if the string is not a valid timestamp, or `std::errc::result_out_of_range` if it cannot
+ *         be represented by `Duration`.
+ */
+template <typename Duration = std::chrono::nanoseconds>
+auto parse_timestamp(std::string_view str) noexcept -> result<sys_time<Duration>, std::errc>
+{
+  const auto parts = detail::parse_iso_timestamp(str, nullptr);
+  if (parts.is_error()) return parts.unwrap_error();
+  return detail::to_sys_time<Duration>(parts.unwrap_or({}));
+}
+
+/**
+ * @brief Exceptionlessly parse a timestamp given as seconds since the Unix epoch.
+ *
+ * Accepts the format of `from_string_fixed`, e.g. `1700000000.123456789`, with up to nine
+ * significant fractional digits.
+ *
+ * Example:
+ * @snippet timestamp_test.cpp parse_epoch_timestamp-example
+ *
+ * @tparam Duration The precision of the returned time point.
+ * @param str The string to parse.
+ * @return result<sys_time<Duration>, std::errc> The point in time, or the error of
+ *         `from_string_fixed`.
+ */
+template <typename Duration = std::chrono::nanoseconds>
+auto parse_epoch_timestamp(std::string_view str) noexcept -> result<sys_time<Duration>, std::errc>
+{
+  // Floored like `parse_timestamp`, so times before the epoch round down as well.
+  return from_string_fixed<9>(str).map([](std::int64_t nanoseconds) {
+    return sys_time<Duration>{std::chrono::floor<Duration>(std::chrono::nanoseconds{nanoseconds})};
+  });
+}
+
+/**
+ * @brief Format a timestamp as ISO-8601 in UTC into a buffer.
+ *
+ * Writes `YYYY-MM-DDTHH:MM:SS`, the fraction of a second with as many digits as needed for the
+ * precision of `Duration`, and `Z`.
+ *
+ * @param time The point in time to format.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @return result<char*, std::errc> One past the last written character, or
+ *         `std::errc::value_too_large` if the buffer is too small or the year is outside 0-9999.
+ */
+template <typename Duration>
+auto format_timestamp(const sys_time<Duration>& time, char* first, char* last) noexcept
+    -> result<char*, std::errc>
+{
+  return detail::format_timestamp(time, first, last, nullptr, nullptr);
+}
+
+/**
+ * @brief Format a timestamp as ISO-8601 in UTC.
+ *
+ * Example:
+ * @snippet timestamp_test.cpp format_timestamp-example
+ *
+ * @param time The point in time to format.
+ * @return result<std::string, std::errc> The formatted timestamp, or `std::errc::value_too_large`
+ *         if the year is outside 0-9999.
+ */
+template <typename Duration>
+auto format_timestamp(const sys_time<Duration>& time) -> result<std::string, std::errc>
+{
+  std::array<char, detail::timestamp_size<Duration>()> buffer{};
+  return format_timestamp(time, buffer.data(), buffer.data() + buffer.size())
+      .map([&buffer](char* end) { return std::string(buffer.data(), end); });
+}
+
+/**
+ * @brief Parses consecutive ISO-8601 timestamps, reusing the date of the previous one.
+ *
+ * Log records mostly carry timestamps of the same day, so the date is only converted when its
+ * characters change. Accepts the same formats as `parse_timestamp`.
+ *
+ * Example:
+ * @snippet timestamp_test.cpp timestamp_parser-example
+ */
+class timestamp_parser {
+ public:
+  /**
+   * @brief Parse a timestamp, see `parse_timestamp`.
+   */
+  template <typename Duration = std::chrono::nanoseconds>
+  auto parse(std::string_view str) noexcept -> result<sys_time<Duration>, std::errc>
+  {
+    const auto parts = detail::parse_iso_timestamp(str, &cache_);
+    if (parts.is_error()) return parts.unwrap_error();
+    return detail::to_sys_time<Duration>(parts.unwrap_or({}));
+  }
+
+ private:
+  detail::date_cache cache_;
+};
+
+/**
+ * @brief Formats consecutive timestamps, reusing the date of the previous one.
+ *
+ * Example:
+ * @snippet timestamp_test.cpp timestamp_formatter-example
+ */
+class timestamp_formatter {
+ public:
+  /**
+   * @brief Format a timestamp into a buffer, see `format_timestamp`.
+   */
+  template <typename Duration>
+  auto format(const sys_time<Duration>& time, char* first, char* last) noexcept
+      -> result<char*, std::errc>
+  {
+    return detail::format_timestamp(time, first, last, &day_, date_.data());
+  }
+
+  /**
+   * @brief Format a timestamp, see `format_timestamp`.
+   */
+  template <typename Duration>
+  auto format(const sys_time<Duration>& time) -> result<std::string, std::errc>
+  {
+    std::array<char, detail::timestamp_size<Duration>()> buffer{};
+    return format(time, buffer.data(), buffer.data() + buffer.size()).map([&buffer](char* end) {
+      return std::string(buffer.data(), end);
+    });
+  }
+
+ private:
+  std::int64_t day_{std::numeric_limits<std::int64_t>::min()};
+  std::array<char, 11> date_{};
+};
+
+}  // namespace bricks
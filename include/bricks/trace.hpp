@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/**
+ * @brief Number of spans kept per thread before the oldest ones are overwritten.
+ */
+#ifndef BRICKS_TRACE_BUFFER_SIZE
+#define BRICKS_TRACE_BUFFER_SIZE 4096
+#endif
+
+#define BRICKS_TRACE_CONCAT_IMPL_(a, b) a##b
+#define BRICKS_TRACE_CONCAT_(a, b) BRICKS_TRACE_CONCAT_IMPL_(a, b)
+
+/**
+ * @brief Record the enclosing scope as a span named `name`.
+ *
+ * Expands to a `bricks::trace_scope` when `BRICKS_ENABLE_TRACE` is defined and to nothing
+ * otherwise. The name must have static storage duration, e.g. a string literal.
+ *
+ * Example:
+ * @snippet trace_test.cpp trace-example
+ */
+#ifdef BRICKS_ENABLE_TRACE
+#define BRICKS_TRACE_SCOPE(name) \
+  const ::bricks::trace_scope BRICKS_TRACE_CONCAT_(bricks_trace_scope_, __LINE__) { name }
+#else
+#define BRICKS_TRACE_SCOPE(name) static_cast<void>(0)
+#endif
+
+namespace bricks {
+
+/**
+ * @brief Whether `BRICKS_TRACE_SCOPE` records spans, i.e. whether `BRICKS_ENABLE_TRACE` is defined.
+ */
+#ifdef BRICKS_ENABLE_TRACE
+inline constexpr bool trace_enabled = true;
+#else
+inline constexpr bool trace_enabled = false;
+#endif
+
+/**
+ * @brief A completed span, as returned by `collect_trace`.
+ */
+struct trace_event {
+  /** @brief The name the span was recorded with. */
+  const char* name;
+  /** @brief Sequential id of the thread that recorded the span. */
+  std::uint32_t thread_id;
+  /** @brief Start of the span in nanoseconds since the trace epoch. */
+  std::int64_t begin_ns;
+  /** @brief End of the span in nanoseconds since the trace epoch. */
+  std::int64_t end_ns;
+};
+
+namespace detail {
+
+inline const std::chrono::steady_clock::time_point trace_epoch = std::chrono::steady_clock::now();
+
+inline auto trace_now() noexcept -> std::int64_t
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                              trace_epoch)
+      .count();
+}
+
+/**
+ * @brief Single producer ring buffer holding the spans of one thread.
+ *
+ * Only the owning thread writes. Every slot carries the sequence number of the span it holds, which
+ * readers check before and after copying it (seqlock style), so a slot that is overwritten while
+ * being read is skipped instead of torn and neither side ever blocks.
+ */
+class trace_buffer {
+ public:
+  static constexpr std::uint64_t capacity = BRICKS_TRACE_BUFFER_SIZE;
+
+  explicit trace_buffer(std::uint32_t thread_id) noexcept : thread_id_(thread_id) {}
+
+  auto push(const char* name, std::int64_t begin_ns, std::int64_t end_ns) noexcept -> void
+  {
+    const auto head = head_.load(std::memory_order_relaxed);
+    auto& s = slots_[head % capacity];
+    s.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    s.name.store(name, std::memory_order_relaxed);
+    s.begin_ns.store(begin_ns, std::memory_order_relaxed);
+    s.end_ns.store(end_ns, std::memory_order_relaxed);
+    s.sequence.store(head + 1, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_release);
+  }
+
+  auto collect(std::vector<trace_event>& out) const -> void
+  {
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto oldest = head > capacity ? head - capacity : 0;
+
+    for (auto index = std::max(oldest, start_.load(std::memory_order_relaxed)); index < head;
+         ++index) {
+      const auto& s = slots_[index % capacity];
+      const auto sequence = s.sequence.load(std::memory_order_acquire);
+      const trace_event event{s.name.load(std::memory_order_relaxed), thread_id_,
+                              s.begin_ns.load(std::memory_order_relaxed),
+                              s.end_ns.load(std::memory_order_relaxed)};
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (sequence == index + 1 && s.sequence.load(std::memory_order_relaxed) == sequence) {
+        out.push_back(event);
+      }
+    }
+  }
+
+  auto clear() noexcept -> void
+  {
+    start_.store(head_.load(std::memory_order_acquire), std::memory_order_relaxed);
+  }
+
+ private:
+  struct slot {
+    std::atomic<std::uint64_t> sequence{0};
+    std::atomic<const char*> name{nullptr};
+    std::atomic<std::int64_t> begin_ns{0};
+    std::atomic<std::int64_t> end_ns{0};
+  };
+
+  std::uint32_t thread_id_;
+  std::atomic<std::uint64_t> head_{0};
+  std::atomic<std::uint64_t> start_{0};
+  std::array<slot, capacity> slots_{};
+};
+
+/**
+ * @brief Owns the buffers of all threads that ever recorded a span.
+ *
+ * Buffers are shared with their thread, so spans of threads that already exited can still be
+ * dumped. The lock is only taken when a thread records its first span and when dumping.
+ */
+class trace_registry {
+ public:
+  static auto instance() -> trace_registry&
+  {
+    static trace_registry registry;
+    return registry;
+  }
+
+  auto register_thread() noexcept -> std::shared_ptr<trace_buffer>
+  {
+    try {
+      const std::lock_guard lock{mutex_};
+      auto buffer = std::make_shared<trace_buffer>(static_cast<std::uint32_t>(buffers_.size()));
+      buffers_.push_back(buffer);
+      return buffer;
+    } catch (...) {
+      return nullptr;
+    }
+  }
+
+  auto collect() const -> std::vector<trace_event>
+  {
+    std::vector<trace_event> events;
+    const std::lock_guard lock{mutex_};
+    for (const auto& buffer : buffers_) {
+      buffer->collect(events);
+    }
+    return events;
+  }
+
+  auto clear() noexcept -> void
+  {
+    const std::lock_guard lock{mutex_};
+    for (const auto& buffer : buffers_) {
+      buffer->clear();
+    }
+  }
+
+ private:
+  trace_registry() = default;
+
+  mutable std::mutex mutex_;
+  std::vector<std::shared_ptr<trace_buffer>> buffers_;
+};
+
+inline auto local_trace_buffer() noexcept -> trace_buffer*
+{
+  thread_local const std::shared_ptr<trace_buffer> buffer =
+      trace_registry::instance().register_thread();
+  return buffer.get();
+}
+
+inline auto write_trace_timestamp(std::ostream& out, std::int64_t ns) -> void
+{
+  // Chrome expects microseconds, keep the nanoseconds as fraction.
+  constexpr std::int64_t ns_per_us = 1000;
+  const auto frac = ns % ns_per_us;
+  out << ns / ns_per_us << '.' << static_cast<char>('0' + frac / 100)
+      << static_cast<char>('0' + frac / 10 % 10) << static_cast<char>('0' + frac % 10);
+}
+
+inline auto write_trace_string(std::ostream& out, const char* str) -> void
+{
+  // JSON forbids raw control characters in strings.
+  constexpr const char* hex_digits = "0123456789abcdef";
+  out << '"';
+  for (; *str != '\0'; ++str) {
+    const auto c = static_cast<unsigned char>(*str);
+    if (c == '"' || c == '\\') {
+      out << '\\' << *str;
+    } else if (c == '\n') {
+      out << "\\n";
+    } else if (c == '\t') {
+      out << "\\t";
+    } else if (c < 0x20) {
+      out << "\\u00" << hex_digits[c >> 4] << hex_digits[c & 0xf];
+    } else {
+      out << *str;
+    }
+  }
+  out << '"';
+}
+
+}  // namespace detail
+
+/**
+ * @brief Records the lifetime of a scope as a span in the current thread's trace buffer.
+ *
+ * Recording neither allocates nor locks, except for the very first span of each thread, which
+ * registers the thread's ring buffer. Usually used through `BRICKS_TRACE_SCOPE`.
+ *
+ * Example:
+ * @snippet trace_test.cpp trace_scope-example
+ */
+class trace_scope {
+ public:
+  /**
+   * @brief Start a span.
+   *
+   * @param name The name of the span. Must outlive the trace, e.g. a string literal.
+   */
+  explicit trace_scope(const char* name) noexcept : name_(name), begin_ns_(detail::trace_now()) {}
+
+  trace_scope(const trace_scope&) = delete;
+  auto operator=(const trace_scope&) -> trace_scope& = delete;
+  trace_scope(trace_scope&&) = delete;
+  auto operator=(trace_scope&&) -> trace_scope& = delete;
+
+  /** @brief End the span and record it. */
+  ~trace_scope()
+  {
+    if (auto* buffer = detail::local_trace_buffer()) {
+      buffer->push(name_, begin_ns_, detail::trace_now());
+    }
+  }
+
+ private:
+  const char* name_;
+  std::int64_t begin_ns_;
+};
+
+/**
+ * @brief Collect the spans currently held by all thread buffers.
+ *
+ * Can be called while other threads keep recording; spans overwritten during the copy are
+ * dropped.
+ *
+ * @return std::vector<trace_event> The spans, grouped by thread and ordered by completion.
+ */
+inline auto collect_trace() -> std::vector<trace_event>
+{
+  return detail::trace_registry::instance().collect();
+}
+
+/**
+ * @brief Discard all spans recorded so far.
+ */
+inline auto clear_trace() noexcept -> void { detail::trace_registry::instance().clear(); }
+
+/**
+ * @brief Write all recorded spans in the Chrome trace event JSON format.
+ *
+ * The output can be loaded in `chrome://tracing` or the Perfetto UI.
+ *
+ * Example:
+ * @snippet trace_test.cpp trace-example
+ *
+ * @param out The stream to write to.
+ */
+inline auto write_chrome_trace(std::ostream& out) -> void
+{
+  out << R"({"displayTimeUnit":"ns","traceEvents":[)";
+  bool first = true;
+  for (const auto& event : collect_trace()) {
+    out << (first ? "" : ",") << R"({"name":)";
+    detail::write_trace_string(out, event.name);
+    out << R"(,"cat":"bricks","ph":"X","pid":1,"tid":)" << event.thread_id << R"(,"ts":)";
+    detail::write_trace_timestamp(out, event.begin_ns);
+    out << R"(,"dur":)";
+    detail::write_trace_timestamp(out, event.end_ns - event.begin_ns);
+    out << '}';
+    first = false;
+  }
+  out << "]}";
+}
+
+}  // namespace bricks
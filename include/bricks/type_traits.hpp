@@ -16,6 +16,36 @@ struct has_find<T, U, std::void_t<decltype(std::declval<T>().find(std::declval<U
     : std::true_type {
 };
 
+template <typename T, typename = void>
+struct has_extract : std::false_type {
+};
+
+template <typename T>
+struct has_extract<T, std::void_t<decltype(std::declval<T&>().extract(std::declval<T&>().begin()))>>
+    : std::true_type {
+};
+
+template <typename R, typename = void>
+struct is_sized_range : std::false_type {
+};
+
+template <typename R>
+struct is_sized_range<R, std::void_t<decltype(std::size(std::declval<const R&>()))>>
+    : std::true_type {
+};
+
+template <typename R, typename = void>
+struct is_contiguous_range : std::false_type {
+};
+
+template <typename R>
+struct is_contiguous_range<R, std::void_t<decltype(std::data(std::declval<R&>())),
+                                          decltype(std::begin(std::declval<R&>()))>>
+    : std::is_same<
+          std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<R&>()))>>,
+          typename std::iterator_traits<decltype(std::begin(std::declval<R&>()))>::value_type> {
+};
+
 template <typename T, typename = void>
 struct is_iterator : std::false_type {
 };
@@ -79,4 +109,135 @@ struct is_iterator : detail::is_iterator<T>::type {
 template <typename T>
 inline constexpr bool is_iterator_v = is_iterator<T>::value;
 
+/**
+ * @brief Checks if a type is a random access iterator.
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct is_random_access_iterator
+    : std::is_base_of<std::random_access_iterator_tag,
+                      typename std::iterator_traits<T>::iterator_category> {
+};
+
+/**
+ * @relates is_random_access_iterator
+ * @brief Helper variable template to check if a type is a random access iterator.
+ */
+template <typename T>
+inline constexpr bool is_random_access_iterator_v = is_random_access_iterator<T>::value;
+
+/**
+ * @brief The iterator type of a range, i.e. the type `std::begin` returns for it.
+ */
+template <typename R>
+using range_iterator_t = decltype(std::begin(std::declval<R&>()));
+
+/**
+ * @brief The type of the elements of a range.
+ *
+ * Example:
+ * @snippet type_traits_test.cpp range-traits-example
+ */
+template <typename R>
+using range_value_t = typename std::iterator_traits<range_iterator_t<R>>::value_type;
+
+/**
+ * @brief Checks if the number of elements of a range is known without iterating it, i.e. if
+ *        `std::size` works for it.
+ *
+ * @tparam R The type to check.
+ */
+template <typename R>
+struct is_sized_range : detail::is_sized_range<R>::type {
+};
+
+/**
+ * @relates is_sized_range
+ * @brief Helper variable template to check if a range is sized.
+ */
+template <typename R>
+inline constexpr bool is_sized_range_v = is_sized_range<R>::value;
+
+/**
+ * @brief Checks if the iterators of a range are random access iterators.
+ *
+ * @tparam R The type to check.
+ */
+template <typename R>
+struct is_random_access_range : is_random_access_iterator<range_iterator_t<R>> {
+};
+
+/**
+ * @relates is_random_access_range
+ * @brief Helper variable template to check if a range has random access iterators.
+ */
+template <typename R>
+inline constexpr bool is_random_access_range_v = is_random_access_range<R>::value;
+
+/**
+ * @brief Checks if a range stores its elements next to each other in memory.
+ *
+ * C++17 has no contiguous iterator category, so these are the ranges for which `std::data`
+ * returns a pointer to their elements, like arrays, `std::vector`, `std::array` and strings.
+ *
+ * @tparam R The type to check.
+ */
+template <typename R>
+struct is_contiguous_range : detail::is_contiguous_range<R>::type {
+};
+
+/**
+ * @relates is_contiguous_range
+ * @brief Helper variable template to check if a range is contiguous.
+ */
+template <typename R>
+inline constexpr bool is_contiguous_range_v = is_contiguous_range<R>::value;
+
+/**
+ * @brief Checks if objects of a type are equal exactly if their bytes are equal, so they can be
+ *        compared with `memcmp`, `memchr` or SIMD instructions.
+ *
+ * True for integers, enumerations and pointers. Floating point types are not, as `0.0 == -0.0` and
+ * `NaN != NaN`. Specialize this trait as `std::true_type` for types without padding whose
+ * `operator==` compares all members.
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct is_bitwise_comparable
+    : std::bool_constant<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>> {
+};
+
+/**
+ * @relates is_bitwise_comparable
+ * @brief Helper variable template to check if a type is bitwise comparable.
+ */
+template <typename T>
+inline constexpr bool is_bitwise_comparable_v = is_bitwise_comparable<T>::value;
+
+/**
+ * @brief Checks if objects of a type can be moved to another address with `memcpy`, without
+ *        calling the move constructor and the destructor.
+ *
+ * Trivially copyable types are. Specialize this trait as `std::true_type` for other types that do
+ * not store pointers into themselves and are not registered by their address elsewhere, e.g. a
+ * handle owning a heap pointer. Containers like `small_vector` then relocate them in bulk.
+ *
+ * @tparam T The type to check.
+ */
+template <typename T>
+struct is_trivially_relocatable : std::is_trivially_copyable<T> {
+};
+
+/**
+ * @relates is_trivially_relocatable
+ * @brief Helper variable template to check if a type is trivially relocatable.
+ *
+ * Example:
+ * @snippet type_traits_test.cpp is_trivially_relocatable-example
+ */
+template <typename T>
+inline constexpr bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
 }  // namespace bricks
@@ -0,0 +1,360 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "cpu_features.hpp"
+#include "detail/utf8_simd.hpp"
+#include "result.hpp"
+
+namespace bricks {
+
+/**
+ * @brief The error of a failed UTF-8 or UTF-16 operation.
+ */
+struct utf_error {
+  /**
+   * @brief `std::errc::illegal_byte_sequence` for invalid input, `std::errc::value_too_large` if
+   * the output buffer is too small.
+   */
+  std::errc code;
+  /** @brief The offset of the offending character in the input, in code units. */
+  std::size_t offset;
+
+  [[nodiscard]] friend constexpr auto operator==(const utf_error& lhs,
+                                                 const utf_error& rhs) noexcept -> bool
+  {
+    return lhs.code == rhs.code && lhs.offset == rhs.offset;
+  }
+  [[nodiscard]] friend constexpr auto operator!=(const utf_error& lhs,
+                                                 const utf_error& rhs) noexcept -> bool
+  {
+    return !(lhs == rhs);
+  }
+};
+
+namespace detail {
+
+/**
+ * @brief Decode the character starting at `pos`.
+ *
+ * @return std::size_t The length of the character, or 0 if it is not valid UTF-8. Overlong
+ *         encodings, surrogates and values above U+10FFFF are invalid.
+ */
+inline auto decode_utf8(const unsigned char* in, std::size_t size, std::size_t pos,
+                        char32_t& code_point) noexcept -> std::size_t
+{
+  const auto lead = in[pos];
+  std::size_t length = 0;
+  char32_t min = 0;
+  if (lead < 0x80U) {
+    code_point = lead;
+    return 1;
+  }
+  if ((lead & 0xe0U) == 0xc0U) {
+    length = 2;
+    min = 0x80;
+    code_point = lead & 0x1fU;
+  } else if ((lead & 0xf0U) == 0xe0U) {
+    length = 3;
+    min = 0x800;
+    code_point = lead & 0x0fU;
+  } else if ((lead & 0xf8U) == 0xf0U) {
+    length = 4;
+    min = 0x10000;
+    code_point = lead & 0x07U;
+  } else {
+    return 0;
+  }
+
+  if (size - pos < length) return 0;
+  for (std::size_t i = 1; i < length; ++i) {
+    const auto next = in[pos + i];
+    if ((next & 0xc0U) != 0x80U) return 0;
+    code_point = (code_point << 6U) | (next & 0x3fU);
+  }
+  if (code_point < min || code_point > 0x10ffff || (code_point >= 0xd800 && code_point <= 0xdfff)) {
+    return 0;
+  }
+  return length;
+}
+
+/**
+ * @brief Validate from `pos` on, skipping eight ASCII bytes at a time.
+ *
+ * @return std::size_t The offset of the first invalid character, or `size`.
+ */
+inline auto validate_utf8_scalar(const unsigned char* in, std::size_t size,
+                                 std::size_t pos) noexcept -> std::size_t
+{
+  while (pos < size) {
+    if (size - pos >= 8) {
+      std::uint64_t word = 0;
+      std::memcpy(&word, in + pos, sizeof(word));
+      if ((word & 0x8080808080808080U) == 0) {
+        pos += 8;
+        continue;
+      }
+    }
+    char32_t code_point = 0;
+    const auto length = decode_utf8(in, size, pos, code_point);
+    if (length == 0) return pos;
+    pos += length;
+  }
+  return size;
+}
+
+using utf8_kernel = std::size_t(const unsigned char*, std::size_t);
+
+inline auto skip_none(const unsigned char* /* in */, std::size_t /* size */) noexcept
+    -> std::size_t
+{
+  return 0;
+}
+
+inline auto ascii_prefix(const unsigned char* in, std::size_t size) noexcept -> std::size_t
+{
+  static const cpu_dispatch<utf8_kernel> kernels{ascii_prefix_sse2, nullptr, ascii_prefix_avx2};
+  return kernels(in, size);
+}
+
+inline auto valid_utf8_prefix(const unsigned char* in, std::size_t size) noexcept -> std::size_t
+{
+  static const cpu_dispatch<utf8_kernel> kernels{skip_none, validate_utf8_ssse3,
+                                                 validate_utf8_avx2};
+  return kernels(in, size);
+}
+
+inline auto widen_ascii(const unsigned char* in, std::size_t size, char16_t* out) noexcept
+    -> std::size_t
+{
+  static const cpu_dispatch<std::size_t(const unsigned char*, std::size_t, char16_t*)> kernels{
+      widen_ascii_sse2, nullptr, widen_ascii_avx2};
+  return kernels(in, size, out);
+}
+
+inline auto narrow_ascii(const char16_t* in, std::size_t size, char* out) noexcept -> std::size_t
+{
+  static const cpu_dispatch<std::size_t(const char16_t*, std::size_t, char*)> kernels{
+      narrow_ascii_sse2, nullptr, narrow_ascii_avx2};
+  return kernels(in, size, out);
+}
+
+inline auto as_utf8_bytes(std::string_view str) noexcept -> const unsigned char*
+{
+  return reinterpret_cast<const unsigned char*>(str.data());  // NOLINT
+}
+
+}  // namespace detail
+
+/**
+ * @brief Check whether a string consists of ASCII characters only.
+ *
+ * Tests 64 bytes per iteration with SSE2, or 128 with AVX2 if the CPU supports it.
+ *
+ * Example:
+ * @snippet utf8_test.cpp is_ascii-example
+ *
+ * @param str The string to check.
+ * @return true If no byte has its top bit set.
+ */
+inline auto is_ascii(std::string_view str) noexcept -> bool
+{
+  const auto* in = detail::as_utf8_bytes(str);
+  auto pos = detail::ascii_prefix(in, str.size());
+  for (; pos < str.size(); ++pos) {
+    if (in[pos] >= 0x80U) return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Validate UTF-8.
+ *
+ * Uses the lookup algorithm of Keiser and Lemire with SSSE3 or AVX2 if the CPU supports it, which
+ * checks a whole block of bytes with a few table lookups. Only when a block contains an error is
+ * the exact position determined with the scalar validator.
+ *
+ * Overlong encodings, surrogates, values above U+10FFFF and truncated characters are invalid.
+ *
+ * Example:
+ * @snippet utf8_test.cpp validate_utf8-example
+ *
+ * @param str The string to validate.
+ * @return result<std::string_view, utf_error> The string, or the offset of the first invalid
+ *         character with `std::errc::illegal_byte_sequence`.
+ */
+inline auto validate_utf8(std::string_view str) noexcept -> result<std::string_view, utf_error>
+{
+  const auto* in = detail::as_utf8_bytes(str);
+  const auto pos = detail::valid_utf8_prefix(in, str.size());
+  const auto invalid = detail::validate_utf8_scalar(in, str.size(), pos);
+  if (invalid != str.size()) return utf_error{std::errc::illegal_byte_sequence, invalid};
+  return str;
+}
+
+/**
+ * @brief Transcode UTF-8 to UTF-16 into a buffer.
+ *
+ * The input is validated while transcoding. Only runs of ASCII are vectorized, widened 16
+ * characters at a time with SSE2 or 32 with AVX2. All other characters are decoded one at a time,
+ * so text that is mostly not ASCII, e.g. Cyrillic or CJK, transcodes at scalar speed.
+ *
+ * @param str The UTF-8 string.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @return result<char16_t*, utf_error> One past the last written code unit, or the offset of the
+ *         first character that is invalid or does not fit into the buffer.
+ */
+inline auto utf8_to_utf16(std::string_view str, char16_t* first, char16_t* last) noexcept
+    -> result<char16_t*, utf_error>
+{
+  const auto* in = detail::as_utf8_bytes(str);
+  const auto size = str.size();
+  std::size_t pos = 0;
+  char16_t* out = first;
+  while (pos < size) {
+    const auto room = static_cast<std::size_t>(last - out);
+    const auto widened = detail::widen_ascii(in + pos, std::min(size - pos, room), out);
+    pos += widened;
+    out += widened;
+
+    const auto chunk_end = std::min(size, pos + 16);
+    while (pos < chunk_end) {
+      char32_t code_point = 0;
+      const auto length = detail::decode_utf8(in, size, pos, code_point);
+      if (length == 0) return utf_error{std::errc::illegal_byte_sequence, pos};
+
+      const std::size_t units = code_point >= 0x10000 ? 2 : 1;
+      if (static_cast<std::size_t>(last - out) < units) {
+        return utf_error{std::errc::value_too_large, pos};
+      }
+      if (units == 2) {
+        code_point -= 0x10000;
+        *out++ = static_cast<char16_t>(0xd800 + (code_point >> 10U));
+        *out++ = static_cast<char16_t>(0xdc00 + (code_point & 0x3ffU));
+      } else {
+        *out++ = static_cast<char16_t>(code_point);
+      }
+      pos += length;
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief Transcode UTF-8 to UTF-16.
+ *
+ * Example:
+ * @snippet utf8_test.cpp utf8_to_utf16-example
+ *
+ * @param str The UTF-8 string.
+ * @return result<std::u16string, utf_error> The UTF-16 string, or the offset of the first invalid
+ *         character.
+ */
+inline auto utf8_to_utf16(std::string_view str) -> result<std::u16string, utf_error>
+{
+  // Every UTF-8 byte becomes at most one UTF-16 code unit.
+  std::u16string out(str.size(), u'\0');
+  return utf8_to_utf16(str, out.data(), out.data() + out.size())
+      .map([&out](char16_t* end) {
+        out.resize(static_cast<std::size_t>(end - out.data()));
+        return std::move(out);
+      });
+}
+
+/**
+ * @brief Transcode UTF-16 to UTF-8 into a buffer.
+ *
+ * The input is validated while transcoding, unpaired surrogates are invalid. Only runs of ASCII
+ * are vectorized, narrowed 16 characters at a time with SSE2 or 32 with AVX2. All other characters
+ * are encoded one at a time, so text that is mostly not ASCII transcodes at scalar speed.
+ *
+ * @param str The UTF-16 string.
+ * @param first The start of the buffer.
+ * @param last The end of the buffer.
+ * @return result<char*, utf_error> One past the last written byte, or the offset of the first
+ *         code unit that is invalid or does not fit into the buffer.
+ */
+inline auto utf16_to_utf8(std::u16string_view str, char* first, char* last) noexcept
+    -> result<char*, utf_error>
+{
+  const auto size = str.size();
+  std::size_t pos = 0;
+  char* out = first;
+  while (pos < size) {
+    const auto room = static_cast<std::size_t>(last - out);
+    const auto narrowed = detail::narrow_ascii(str.data() + pos, std::min(size - pos, room), out);
+    pos += narrowed;
+    out += narrowed;
+
+    const auto chunk_end = std::min(size, pos + 16);
+    while (pos < chunk_end) {
+      char32_t code_point = str[pos];
+      std::size_t units = 1;
+      if (code_point >= 0xd800 && code_point <= 0xdfff) {
+        const bool paired = code_point <= 0xdbff && pos + 1 < size && str[pos + 1] >= 0xdc00 &&
+                            str[pos + 1] <= 0xdfff;
+        if (!paired) return utf_error{std::errc::illegal_byte_sequence, pos};
+        code_point = 0x10000 + ((code_point - 0xd800) << 10U) + (str[pos + 1] - 0xdc00U);
+        units = 2;
+      }
+
+      const std::size_t length =
+          code_point < 0x80 ? 1 : code_point < 0x800 ? 2 : code_point < 0x10000 ? 3 : 4;
+      if (static_cast<std::size_t>(last - out) < length) {
+        return utf_error{std::errc::value_too_large, pos};
+      }
+      switch (length) {
+        case 1:
+          *out++ = static_cast<char>(code_point);
+          break;
+        case 2:
+          *out++ = static_cast<char>(0xc0U | (code_point >> 6U));
+          *out++ = static_cast<char>(0x80U | (code_point & 0x3fU));
+          break;
+        case 3:
+          *out++ = static_cast<char>(0xe0U | (code_point >> 12U));
+          *out++ = static_cast<char>(0x80U | ((code_point >> 6U) & 0x3fU));
+          *out++ = static_cast<char>(0x80U | (code_point & 0x3fU));
+          break;
+        default:
+          *out++ = static_cast<char>(0xf0U | (code_point >> 18U));
+          *out++ = static_cast<char>(0x80U | ((code_point >> 12U) & 0x3fU));
+          *out++ = static_cast<char>(0x80U | ((code_point >> 6U) & 0x3fU));
+          *out++ = static_cast<char>(0x80U | (code_point & 0x3fU));
+          break;
+      }
+      pos += units;
+    }
+  }
+  return out;
+}
+
+/**
+ * @brief Transcode UTF-16 to UTF-8.
+ *
+ * Example:
+ * @snippet utf8_test.cpp utf8_to_utf16-example
+ *
+ * @param str The UTF-16 string.
+ * @return result<std::string, utf_error> The UTF-8 string, or the offset of the first unpaired
+ *         surrogate.
+ */
+inline auto utf16_to_utf8(std::u16string_view str) -> result<std::string, utf_error>
+{
+  // Every UTF-16 code unit becomes at most three UTF-8 bytes, surrogate pairs four.
+  std::string out(3 * str.size(), '\0');
+  return utf16_to_utf8(str, out.data(), out.data() + out.size()).map([&out](char* end) {
+    out.resize(static_cast<std::size_t>(end - out.data()));
+    return std::move(out);
+  });
+}
+
+}  // namespace bricks
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "timer.hpp"
+
+namespace bricks {
+
+/**
+ * @brief A manually advanced clock for deterministic tests of timer driven code.
+ *
+ * The clock starts at its epoch and only moves when `advance` is called. Timers of type
+ * `basic_timer<virtual_clock>` fire synchronously inside `advance` once their deadline is reached,
+ * so timeouts can be tested in microseconds without sleeping and always behave the same.
+ *
+ * It is not a Clock in the sense of the standard library: every instance has its own time, so
+ * `now()` is a member function instead of a static one, and it cannot be used where
+ * `Clock::now()` is called, e.g. with `std::this_thread::sleep_until`. The types and `is_steady`
+ * only describe its time points. `basic_timer<virtual_clock>` is specialized for it and has the
+ * interface of `basic_timer`, constructed from the clock like any `basic_timer<Clock>{clock}`.
+ *
+ * Example:
+ * @snippet virtual_clock_test.cpp virtual_clock-example
+ */
+class virtual_clock {
+ public:
+  /** @brief The duration type of the clock. */
+  using duration = std::chrono::nanoseconds;
+  /** @brief The arithmetic type of the duration. */
+  using rep = duration::rep;
+  /** @brief The tick period of the clock. */
+  using period = duration::period;
+  /** @brief The time point type of the clock. */
+  using time_point = std::chrono::time_point<virtual_clock, duration>;
+
+  /** @brief The clock never goes backwards. */
+  static constexpr bool is_steady = true;
+
+  /** @brief Construct a clock at its epoch. */
+  virtual_clock() = default;
+
+  /** @brief A clock cannot be copied, since timers refer to it. */
+  virtual_clock(const virtual_clock&) = delete;
+  /** @brief A clock cannot be copied, since timers refer to it. */
+  auto operator=(const virtual_clock&) -> virtual_clock& = delete;
+  /** @brief A clock cannot be moved, since timers refer to it. */
+  virtual_clock(virtual_clock&&) = delete;
+  /** @brief A clock cannot be moved, since timers refer to it. */
+  auto operator=(virtual_clock&&) -> virtual_clock& = delete;
+
+  /** @brief Completes all outstanding timers. */
+  ~virtual_clock() { fire(take_if([](const auto& /* unused */) { return true; })); }
+
+  /**
+   * @brief The current time of this clock.
+   */
+  [[nodiscard]] auto now() const noexcept -> time_point
+  {
+    const std::lock_guard lock{mutex_};
+    return now_;
+  }
+
+  /**
+   * @brief Move the clock forward, firing every timer that is due by the new time.
+   *
+   * Timers fire in the order of their deadlines, on the calling thread, before `advance` returns.
+   * Negative durations are ignored.
+   *
+   * Example:
+   * @snippet virtual_clock_test.cpp virtual_clock-example
+   *
+   * @param step The duration to move the clock by.
+   */
+  template <typename Rep, typename Period>
+  auto advance(const std::chrono::duration<Rep, Period>& step) -> void
+  {
+    std::vector<std::promise<void>> due;
+    {
+      const std::lock_guard lock{mutex_};
+      if (step > std::chrono::duration<Rep, Period>::zero()) {
+        now_ += std::chrono::duration_cast<duration>(step);
+      }
+      const auto end = timers_.upper_bound(now_);
+      for (auto it = timers_.begin(); it != end; ++it) {
+        due.push_back(std::move(it->second.promise));
+      }
+      timers_.erase(timers_.begin(), end);
+    }
+    fire(std::move(due));
+  }
+
+  /**
+   * @brief The number of timers that have not fired yet.
+   */
+  [[nodiscard]] auto pending() const -> std::size_t
+  {
+    const std::lock_guard lock{mutex_};
+    return timers_.size();
+  }
+
+ private:
+  friend class basic_timer<virtual_clock>;
+
+  struct pending_timer {
+    std::uint64_t owner;
+    std::promise<void> promise;
+  };
+
+  auto register_owner() -> std::uint64_t
+  {
+    const std::lock_guard lock{mutex_};
+    return next_owner_++;
+  }
+
+  auto schedule(std::uint64_t owner, duration timeout) -> std::future<void>
+  {
+    std::promise<void> promise;
+    auto future = promise.get_future();
+    {
+      const std::lock_guard lock{mutex_};
+      if (timeout > duration::zero()) {
+        timers_.emplace(now_ + timeout, pending_timer{owner, std::move(promise)});
+        return future;
+      }
+    }
+    promise.set_value();
+    return future;
+  }
+
+  auto cancel(std::uint64_t owner) -> void
+  {
+    fire(take_if([owner](const pending_timer& t) { return t.owner == owner; }));
+  }
+
+  template <typename Predicate>
+  auto take_if(Predicate predicate) -> std::vector<std::promise<void>>
+  {
+    std::vector<std::promise<void>> taken;
+    const std::lock_guard lock{mutex_};
+    for (auto it = timers_.begin(); it != timers_.end();) {
+      if (predicate(it->second)) {
+        taken.push_back(std::move(it->second.promise));
+        it = timers_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    return taken;
+  }
+
+  static auto fire(std::vector<std::promise<void>> promises) -> void
+  {
+    for (auto& promise : promises) {
+      promise.set_value();
+    }
+  }
+
+  mutable std::mutex mutex_;
+  time_point now_{};
+  std::uint64_t next_owner_{1};
+  std::multimap<time_point, pending_timer> timers_;
+};
+
+/**
+ * @brief A timer driven by a `virtual_clock`.
+ *
+ * Behaves like `bricks::timer`, but its completion tokens become ready when the clock is advanced
+ * past their deadline, or when the timer is aborted or destroyed. The interface is that of
+ * `basic_timer`, except that it cannot be default constructed: `virtual_clock` has no static
+ * `now()`, so the timer needs the clock it is constructed from.
+ *
+ * Example:
+ * @snippet virtual_clock_test.cpp virtual_clock-example
+ */
+template <>
+class basic_timer<virtual_clock> {
+ public:
+  /** @brief A completion token that can be used to wait for the timer to complete. */
+  using completion_token = std::future<void>;
+
+  /**
+   * @brief Construct a timer using the given clock.
+   *
+   * @param clock The clock, must outlive the timer.
+   */
+  explicit basic_timer(virtual_clock& clock) : clock_(&clock), owner_(clock.register_owner()) {}
+
+  /** @brief A timer cannot be copied. */
+  basic_timer(const basic_timer&) = delete;
+  /** @brief A timer cannot be copied. */
+  auto operator=(const basic_timer&) -> basic_timer& = delete;
+
+  /** @brief Move constructor. */
+  basic_timer(basic_timer&& other) noexcept
+      : clock_(std::exchange(other.clock_, nullptr)), owner_(other.owner_)
+  {
+  }
+  /** @brief Move assignment operator. */
+  auto operator=(basic_timer&& other) noexcept -> basic_timer&
+  {
+    if (this != &other) {
+      abort();
+      clock_ = std::exchange(other.clock_, nullptr);
+      owner_ = other.owner_;
+    }
+    return *this;
+  }
+
+  /** @brief Destroy the timer, aborting all outstanding timers. */
+  ~basic_timer() { abort(); }
+
+  /**
+   * @brief Starts the timer, returning a completion token that will be completed when the clock
+   * has been advanced by `duration`.
+   *
+   * @param duration The duration to wait before completing the token. Durations that are not
+   * positive complete the token immediately.
+   * @return completion_token The token.
+   */
+  template <typename Rep = int64_t, typename Period = std::ratio<1>>
+  [[nodiscard]] auto start(const std::chrono::duration<Rep, Period>& duration =
+                               std::chrono::duration<Rep, Period>{}) const noexcept
+      -> completion_token
+  {
+    return clock_->schedule(owner_,
+                            std::chrono::duration_cast<virtual_clock::duration>(duration));
+  }
+
+  /**
+   * @brief Aborts the timer, completing all its outstanding completion tokens.
+   */
+  inline auto abort() -> void
+  {
+    if (clock_ != nullptr) clock_->cancel(owner_);
+  }
+
+ private:
+  virtual_clock* clock_;
+  std::uint64_t owner_;
+};
+
+}  // namespace bricks
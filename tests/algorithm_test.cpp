@@ -1,16 +1,35 @@
 #include <doctest/doctest.h>
 
 #include <bricks/algorithm.hpp>
+#include <bricks/alloc_tracker.hpp>
 #include <map>
 #include <set>
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 TEST_SUITE_BEGIN("[algorithm]");
 
+namespace {
+
+// An associative container without nodes to extract.
+struct flat_map : std::vector<std::pair<int, std::string>> {
+  using key_type = int;
+  using mapped_type = std::string;
+  using vector::vector;
+};
+
+auto make_const_map() -> const std::map<int, std::string>
+{
+  return {{1, "one"}, {2, "two"}};
+}
+
+}  // namespace
+
 TEST_CASE("keys")
 {
   SUBCASE("test")
@@ -59,6 +78,138 @@ TEST_CASE("values")
   }
 }
 
+TEST_CASE("keys from an rvalue map")
+{
+  SUBCASE("test")
+  {
+    std::map<std::string, int> m = {{"a long key that does not fit the small string buffer", 1},
+                                    {"b", 2}};
+    const auto* first_key = m.begin()->first.data();
+    auto keys = bricks::keys(std::move(m));
+    REQUIRE(keys.size() == 2);
+    CHECK(keys[0].data() == first_key);  // Moved, not copied
+    CHECK(keys[1] == "b");
+    CHECK(m.empty());  // NOLINT(bugprone-use-after-move)
+  }
+
+  SUBCASE("example")
+  {
+    /// [keys-move-example]
+    std::unordered_map<std::string, int> map = {{"a", 1}};
+    auto keys = bricks::keys(std::move(map));  // the map is drained, the keys are moved
+    INFO(keys[0]);                             // prints "a"
+    /// [keys-move-example]
+  }
+}
+
+TEST_CASE("values from an rvalue map")
+{
+  SUBCASE("test")
+  {
+    std::map<int, std::string> m = {{1, "a long value that does not fit the small string buffer"},
+                                    {2, "two"}};
+    const auto* first_value = m.begin()->second.data();
+    auto values = bricks::values(std::move(m));
+    REQUIRE(values.size() == 2);
+    CHECK(values[0].data() == first_value);  // Moved, not copied
+    CHECK(values[1] == "two");
+    CHECK(m.empty());  // NOLINT(bugprone-use-after-move)
+  }
+
+  SUBCASE("const rvalues are copied")
+  {
+    const std::map<int, std::string> m = {{1, "one"}};
+    auto values = bricks::values(std::move(m));  // NOLINT(performance-move-const-arg)
+    CHECK(values == std::vector<std::string>{"one"});
+    CHECK(m.at(1) == "one");  // NOLINT(bugprone-use-after-move)
+
+    auto keys = bricks::keys(make_const_map());
+    CHECK(keys == std::vector<int>{1, 2});
+  }
+
+  SUBCASE("lvalues are still copied")
+  {
+    std::map<int, std::string> m = {{1, "one"}};
+    auto values = bricks::values(m);
+    CHECK(values[0] == "one");
+    CHECK(m.at(1) == "one");
+  }
+
+  SUBCASE("non node based container")
+  {
+    flat_map m{{1, "one"}, {2, "two"}};
+    auto values = bricks::values(std::move(m));
+    CHECK(values == std::vector<std::string>{"one", "two"});
+    CHECK(m.empty());  // NOLINT(bugprone-use-after-move)
+  }
+
+  SUBCASE("example")
+  {
+    /// [values-move-example]
+    std::map<int, std::string> map = {{1, "one"}, {2, "two"}};
+    auto values = bricks::values(std::move(map));  // no string is copied
+    for (const auto& value : values) {
+      INFO(value);  // prints "one", "two"
+    }
+    /// [values-move-example]
+  }
+}
+
+TEST_CASE("keys into a small_vector")
+{
+  SUBCASE("test")
+  {
+    std::map<int, std::string> m = {{1, "one"}, {2, "two"}, {3, "three"}};
+    const bricks::allocation_counter counter;
+    auto keys = bricks::keys<4>(m);
+    CHECK(counter.allocations() == 0);
+    CHECK(keys.is_inline());
+    CHECK(keys == bricks::small_vector<int, 4>{1, 2, 3});
+  }
+
+  SUBCASE("more keys than inline capacity")
+  {
+    std::map<int, std::string> m = {{1, "one"}, {2, "two"}, {3, "three"}};
+    auto keys = bricks::keys<2>(m);
+    CHECK_FALSE(keys.is_inline());
+    CHECK(keys == bricks::small_vector<int, 2>{1, 2, 3});
+  }
+
+  SUBCASE("example")
+  {
+    /// [keys-small_vector-example]
+    std::map<int, std::string> map = {{1, "a"}, {2, "b"}, {3, "c"}};
+    auto keys = bricks::keys<4>(map);  // no allocation, the three keys are stored inline
+    for (auto key : keys) {
+      INFO(key);  // prints 1, 2, 3
+    }
+    /// [keys-small_vector-example]
+  }
+}
+
+TEST_CASE("values into a small_vector")
+{
+  SUBCASE("test")
+  {
+    std::map<std::string, int> m = {{"one", 1}, {"two", 2}, {"three", 3}};
+    const bricks::allocation_counter counter;
+    auto values = bricks::values<4>(m);
+    CHECK(counter.allocations() == 0);
+    CHECK(values == bricks::small_vector<int, 4>{1, 3, 2});
+  }
+
+  SUBCASE("example")
+  {
+    /// [values-small_vector-example]
+    std::map<std::string, int> map = {{"a", 1}, {"b", 2}, {"c", 3}};
+    auto values = bricks::values<4>(map);
+    for (auto value : values) {
+      INFO(value);  // prints 1, 2, 3
+    }
+    /// [values-small_vector-example]
+  }
+}
+
 TEST_CASE("bind_front")
 {
   SUBCASE("test")
@@ -0,0 +1,145 @@
+#include <doctest/doctest.h>
+
+#define BRICKS_ALLOC_TRACKING_IMPLEMENTATION
+#include <algorithm>
+#include <bricks/algorithm.hpp>
+#include <bricks/alloc_tracker.hpp>
+#include <bricks/charconv.hpp>
+#include <bricks/result.hpp>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_SUITE_BEGIN("[alloc_tracker]");
+
+namespace {
+
+// Keeps the compiler from eliding allocations whose result is otherwise unused.
+void* volatile sink = nullptr;
+
+auto escape(void* p) -> void { sink = p; }
+
+auto tag_stats(const char* tag) -> bricks::alloc_stats
+{
+  const auto report = bricks::alloc_tag_report();
+  const auto it = std::find_if(report.begin(), report.end(),
+                               [tag](const auto& entry) { return entry.first == tag; });
+  return it != report.end() ? it->second : bricks::alloc_stats{};
+}
+
+}  // namespace
+
+TEST_CASE("hook is installed")
+{
+  CHECK(bricks::alloc_tracking_installed());
+}
+
+TEST_CASE("allocation_counter example")
+{
+  /// [allocation_counter-example]
+  const bricks::allocation_counter counter;
+
+  auto values = std::make_unique<std::vector<int>>(10);
+  escape(values->data());
+
+  CHECK(counter.allocations() == 2);  // The vector and its buffer
+  CHECK(counter.bytes() >= 10 * sizeof(int));
+  /// [allocation_counter-example]
+}
+
+TEST_CASE("count_allocations example")
+{
+  /// [count_allocations-example]
+  const auto stats = bricks::count_allocations([] {
+    const auto str = bricks::to_string(42);
+    CHECK(str.unwrap_or("") == "42");
+  });
+
+  CHECK(stats.allocations == 0);  // Small strings do not allocate
+  /// [count_allocations-example]
+}
+
+TEST_CASE("deallocations are counted")
+{
+  const auto stats = bricks::count_allocations([] { escape(std::make_unique<int>(1).get()); });
+  CHECK(stats.allocations == 1);
+  CHECK(stats.deallocations == 1);
+  CHECK(stats.bytes == sizeof(int));
+}
+
+TEST_CASE("bricks hot paths do not allocate")
+{
+  SUBCASE("from_string")
+  {
+    CHECK(bricks::count_allocations([] { CHECK(bricks::from_string<int>("123").is_value()); })
+              .allocations == 0);
+  }
+
+  SUBCASE("result copies")
+  {
+    const bricks::result<int, std::errc> res{42};
+    CHECK(bricks::count_allocations([&res] {
+            auto copy = res;
+            CHECK(copy.map([](int i) { return i * 2; }).unwrap_or(0) == 84);
+          }).allocations == 0);
+  }
+}
+
+TEST_CASE("keys allocates exactly once")
+{
+  const std::map<int, int> map{{1, 2}, {3, 4}, {5, 6}};
+  CHECK(bricks::count_allocations([&map] { CHECK(bricks::keys(map).size() == 3); }).allocations ==
+        1);
+}
+
+TEST_CASE("alloc_tag example")
+{
+  /// [alloc_tag-example]
+  static const char* const tag = "request parsing";
+  {
+    const bricks::alloc_tag scope{tag};
+    std::vector<int> fields(16);
+    escape(fields.data());
+  }
+
+  for (const auto& [name, stats] : bricks::alloc_tag_report()) {
+    INFO(name, ": ", stats.allocations, " allocations, ", stats.bytes, " bytes");
+  }
+  /// [alloc_tag-example]
+  CHECK(tag_stats(tag).allocations == 1);
+  CHECK(tag_stats(tag).bytes == 16 * sizeof(int));
+}
+
+TEST_CASE("alloc tags nest")
+{
+  static const char* const outer = "outer tag";
+  static const char* const inner = "inner tag";
+  {
+    const bricks::alloc_tag outer_scope{outer};
+    escape(std::make_unique<int>(1).get());
+    {
+      const bricks::alloc_tag inner_scope{inner};
+      escape(std::make_unique<int>(2).get());
+    }
+    escape(std::make_unique<int>(3).get());
+  }
+  escape(std::make_unique<int>(4).get());
+
+  CHECK(tag_stats(outer).allocations == 2);
+  CHECK(tag_stats(inner).allocations == 1);
+}
+
+TEST_CASE("counting_allocator example")
+{
+  /// [counting_allocator-example]
+  const bricks::allocation_counter counter;
+  std::vector<int, bricks::counting_allocator<int>> values;
+  values.reserve(8);
+  escape(values.data());
+  CHECK(counter.allocations() == 1);
+  /// [counting_allocator-example]
+}
+
+TEST_SUITE_END();
@@ -1,8 +1,10 @@
 #include <doctest/doctest.h>
 
+#include <array>
 #include <bricks/charconv.hpp>
 #include <cmath>
 #include <iostream>
+#include <limits>
 #include <stdexcept>
 
 TEST_SUITE_BEGIN("[charconv]");
@@ -46,6 +48,60 @@ TEST_CASE("to_string example")
   /// [to_string-example]
 }
 
+TEST_CASE("to_string with a too small buffer for integers")
+{
+  auto output = bricks::to_string(12345, 4);
+  REQUIRE(output.is_error());
+  CHECK(output.unwrap_error() == std::errc::value_too_large);
+
+  output = bricks::to_string(1234, 4);
+  REQUIRE(output.is_value());
+  CHECK(output.unwrap() == "1234");
+}
+
+TEST_CASE_TEMPLATE("to_fixed_string with integer limits", T, signed char, unsigned char, short,
+                   unsigned short, int, unsigned, long long, unsigned long long)
+{
+  const auto max = bricks::to_fixed_string(std::numeric_limits<T>::max());
+  CHECK(max == std::to_string(std::numeric_limits<T>::max()));
+
+  const auto min = bricks::to_fixed_string(std::numeric_limits<T>::min());
+  CHECK(min == std::to_string(std::numeric_limits<T>::min()));
+  CHECK(bricks::to_fixed_string(T{0}) == "0");
+}
+
+TEST_CASE("to_fixed_string is constexpr for integers")
+{
+  static_assert(bricks::to_fixed_string(-1234) == "-1234");
+  static_assert(bricks::to_fixed_string(0U) == "0");
+  static_assert(decltype(bricks::to_fixed_string(0))::capacity() == 11);
+}
+
+TEST_CASE_TEMPLATE("to_fixed_string with floating point limits", T, float, double, long double)
+{
+  for (const auto value : {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest(),
+                           std::numeric_limits<T>::min(), std::numeric_limits<T>::denorm_min(),
+                           -std::numeric_limits<T>::denorm_min(), T{1} / T{3}}) {
+    std::array<char, 128> expected{};
+    const auto [ptr, ec] = std::to_chars(expected.data(), expected.data() + expected.size(), value);
+    REQUIRE(ec == std::errc{});
+
+    const auto str = bricks::to_fixed_string(value);
+    CHECK(str == std::string_view(expected.data(), ptr - expected.data()));
+  }
+}
+
+TEST_CASE("to_fixed_string example")
+{
+  /// [to_fixed_string-example]
+  constexpr auto answer = bricks::to_fixed_string(42);
+  static_assert(answer == "42");
+
+  const auto third = bricks::to_fixed_string(1.0 / 3.0);
+  CHECK(third == "0.3333333333333333");
+  /// [to_fixed_string-example]
+}
+
 TEST_CASE_TEMPLATE("from_string with valid values", T, int, long, long long, unsigned,
                    unsigned long, unsigned long long)
 {
@@ -81,4 +137,37 @@ TEST_CASE("from_string with invalid values")
   CHECK(value.unwrap_error() == std::errc::invalid_argument);
 }
 
+TEST_CASE("parse_prefix example")
+{
+  /// [parse_prefix-example]
+  auto parsed = bricks::parse_prefix<int>("123,456");
+  REQUIRE(parsed.is_value());
+  CHECK(parsed.unwrap().first == 123);
+  CHECK(parsed.unwrap().second == 3);
+  /// [parse_prefix-example]
+}
+
+TEST_CASE("parse_prefix consumes the whole string")
+{
+  auto parsed = bricks::parse_prefix<double>("-1.5");
+  REQUIRE(parsed.is_value());
+  CHECK(parsed.unwrap().first == -1.5);
+  CHECK(parsed.unwrap().second == 4);
+}
+
+TEST_CASE("parse_prefix with invalid values")
+{
+  auto parsed = bricks::parse_prefix<int>(",1");
+  REQUIRE(parsed.is_error());
+  CHECK(parsed.unwrap_error() == std::errc::invalid_argument);
+
+  parsed = bricks::parse_prefix<int>("99999999999");
+  REQUIRE(parsed.is_error());
+  CHECK(parsed.unwrap_error() == std::errc::result_out_of_range);
+
+  parsed = bricks::parse_prefix<int>("");
+  REQUIRE(parsed.is_error());
+  CHECK(parsed.unwrap_error() == std::errc::invalid_argument);
+}
+
 TEST_SUITE_END();
@@ -1,6 +1,7 @@
 #include <doctest/doctest.h>
 
 #include <bricks/algorithm.hpp>
+#include <cstdint>
 #include <map>
 #include <set>
 #include <stdexcept>
@@ -78,6 +79,18 @@ TEST_CASE("contains")
     CHECK(bricks::contains(s, 'c'));
     CHECK_FALSE(bricks::contains(s, 'd'));
   }
+
+  SUBCASE("contiguous integers")
+  {
+    std::vector<std::uint8_t> bytes(70, 1);
+    CHECK_FALSE(bricks::contains(bytes, std::uint8_t{0xff}));
+    bytes[69] = 0xff;
+    CHECK(bricks::contains(bytes, std::uint8_t{0xff}));
+
+    std::vector<int> ints = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    CHECK(bricks::contains(ints, 9));
+    CHECK_FALSE(bricks::contains(ints, 0));
+  }
 }
 
 TEST_CASE("contains_if")
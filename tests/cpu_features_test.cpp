@@ -0,0 +1,70 @@
+#include <doctest/doctest.h>
+
+#include <bricks/cpu_features.hpp>
+#include <cstddef>
+
+TEST_SUITE_BEGIN("[cpu_features]");
+
+namespace {
+
+auto scalar_kernel(int value) -> int { return value; }
+auto avx2_kernel(int value) -> int { return 2 * value; }
+
+}  // namespace
+
+TEST_CASE("cpu_features example")
+{
+  /// [cpu_features-example]
+  const auto& features = bricks::cpu_features::current();
+  if (features.avx2) {
+    INFO("AVX2 kernels can be used");
+  }
+  /// [cpu_features-example]
+  CHECK(&features == &bricks::cpu_features::current());  // Detected once
+}
+
+TEST_CASE("features are consistent")
+{
+  const auto features = bricks::cpu_features::detect();
+  if (features.avx512bw) CHECK(features.avx512f);
+  if (features.avx2) CHECK(features.ssse3);
+  if (features.ssse3) CHECK(features.sse2);
+#if defined(__x86_64__) && !defined(BRICKS_SIMD_NONE)
+  CHECK(features.sse2);  // Part of x86-64
+#endif
+}
+
+TEST_CASE("best_cpu_target matches the features")
+{
+  const auto target = bricks::best_cpu_target();
+#ifndef BRICKS_SIMD_NATIVE
+  const auto& features = bricks::cpu_features::current();
+  if (target >= bricks::cpu_target::ssse3) CHECK(features.ssse3);
+  if (target >= bricks::cpu_target::avx2) CHECK(features.avx2);
+  if (target == bricks::cpu_target::avx512) CHECK(features.avx512bw);
+  if (features.avx2) CHECK(target >= bricks::cpu_target::avx2);
+#else
+  CHECK(target >= bricks::cpu_target::scalar);
+#endif
+}
+
+TEST_CASE("cpu_dispatch example")
+{
+  /// [cpu_dispatch-example]
+  static const bricks::cpu_dispatch<int(int)> twice{scalar_kernel, nullptr, avx2_kernel};
+  const int result = twice(21);  // Calls avx2_kernel on CPUs with AVX2, else scalar_kernel
+  /// [cpu_dispatch-example]
+  CHECK(result == (bricks::best_cpu_target() >= bricks::cpu_target::avx2 ? 42 : 21));
+  CHECK(twice.resolve() == twice.select(bricks::best_cpu_target()));
+}
+
+TEST_CASE("cpu_dispatch falls back to the next lower kernel")
+{
+  constexpr bricks::cpu_dispatch<int(int)> kernels{scalar_kernel, nullptr, avx2_kernel};
+  CHECK(kernels.select(bricks::cpu_target::scalar) == &scalar_kernel);
+  CHECK(kernels.select(bricks::cpu_target::ssse3) == &scalar_kernel);
+  CHECK(kernels.select(bricks::cpu_target::avx2) == &avx2_kernel);
+  CHECK(kernels.select(bricks::cpu_target::avx512) == &avx2_kernel);
+}
+
+TEST_SUITE_END();
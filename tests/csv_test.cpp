@@ -0,0 +1,138 @@
+#include <doctest/doctest.h>
+
+#include <bricks/csv.hpp>
+#include <bricks/ranges.hpp>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_SUITE_BEGIN("[csv]");
+
+TEST_CASE("csv_reader example")
+{
+  /// [csv_reader-example]
+  const bricks::csv_reader<std::string_view, int, double> reader{',', true};
+  auto parsed = reader.parse("name,count,price\napple,3,0.5\npear,10,1.25\n");
+
+  REQUIRE(parsed.is_value());
+  auto [names, counts, prices] = parsed.unwrap();
+  CHECK(names == std::vector<std::string_view>{"apple", "pear"});
+  CHECK(counts == std::vector<int>{3, 10});
+  CHECK(prices == std::vector<double>{0.5, 1.25});
+
+  double total = 0;
+  for (auto [count, price] : bricks::zip(counts, prices)) {
+    total += count * price;
+  }
+  CHECK(total == 14);
+  /// [csv_reader-example]
+}
+
+TEST_CASE("csv_reader parallel example")
+{
+  /// [csv_reader-parallel-example]
+  std::string input;
+  for (int i = 0; i < 1000; ++i) {
+    input += std::to_string(i) + '\t' + std::to_string(i * 2) + '\n';
+  }
+
+  const bricks::csv_reader<int, std::int64_t> reader{'\t'};
+  auto parsed = reader.parse(input, 4);
+
+  REQUIRE(parsed.is_value());
+  CHECK(parsed.unwrap() == reader.parse(input).unwrap());
+  /// [csv_reader-parallel-example]
+}
+
+TEST_CASE("csv_reader handles line endings and empty lines")
+{
+  const bricks::csv_reader<int, std::string> reader;
+  auto parsed = reader.parse("1,a\r\n\r\n\n2,b\n3,c");
+  REQUIRE(parsed.is_value());
+  CHECK(std::get<0>(parsed.unwrap()) == std::vector<int>{1, 2, 3});
+  CHECK(std::get<1>(parsed.unwrap()) == std::vector<std::string>{"a", "b", "c"});
+
+  auto empty = reader.parse("");
+  REQUIRE(empty.is_value());
+  CHECK(std::get<0>(empty.unwrap()).empty());
+}
+
+TEST_CASE("csv_reader keeps empty fields")
+{
+  const bricks::csv_reader<std::string_view, std::string_view, std::string_view> reader;
+  auto parsed = reader.parse(",,\nx,,y\n");
+  REQUIRE(parsed.is_value());
+  CHECK(std::get<0>(parsed.unwrap()) == std::vector<std::string_view>{"", "x"});
+  CHECK(std::get<1>(parsed.unwrap()) == std::vector<std::string_view>{"", ""});
+  CHECK(std::get<2>(parsed.unwrap()) == std::vector<std::string_view>{"", "y"});
+}
+
+TEST_CASE("csv_reader reports the row and column of errors")
+{
+  const bricks::csv_reader<int, int, int> reader{',', true};
+
+  auto bad_value = reader.parse("a,b,c\n1,2,3\n4,x,6\n");
+  REQUIRE(bad_value.is_error());
+  CHECK(bad_value.unwrap_error() == bricks::csv_error{1, 1, std::errc::invalid_argument});
+
+  auto too_large = reader.parse("a,b,c\n1,2,99999999999\n");
+  REQUIRE(too_large.is_error());
+  CHECK(too_large.unwrap_error() == bricks::csv_error{0, 2, std::errc::result_out_of_range});
+
+  auto too_few = reader.parse("a,b,c\n1,2,3\n\n1,2\n");
+  REQUIRE(too_few.is_error());
+  CHECK(too_few.unwrap_error() == bricks::csv_error{1, 2, std::errc::invalid_argument});
+
+  auto too_many = reader.parse("a,b,c\n1,2,3,4\n");
+  REQUIRE(too_many.is_error());
+  CHECK(too_many.unwrap_error() == bricks::csv_error{0, 3, std::errc::invalid_argument});
+}
+
+TEST_CASE("csv_reader finds separators across block boundaries")
+{
+  const std::string long_field(37, 'x');
+  std::string input;
+  for (int i = 0; i < 50; ++i) {
+    input += long_field.substr(0, static_cast<std::size_t>(i % 37)) + ';';
+    input += std::to_string(i) + '\n';
+  }
+
+  const bricks::csv_reader<std::string_view, int> reader{';'};
+  auto parsed = reader.parse(input);
+  REQUIRE(parsed.is_value());
+  const auto& [fields, numbers] = parsed.unwrap();
+  REQUIRE(numbers.size() == 50);
+  for (std::size_t i = 0; i < numbers.size(); ++i) {
+    CHECK(numbers[i] == static_cast<int>(i));
+    CHECK(fields[i].size() == i % 37);
+  }
+}
+
+TEST_CASE("csv_reader parses in parallel like sequentially")
+{
+  std::string input = "id,value\n";
+  for (int i = 0; i < 5000; ++i) {
+    input += std::to_string(i) + ',' + std::to_string(i % 7 == 0 ? -i : i);
+    input += i % 3 == 0 ? "\r\n" : "\n";
+  }
+
+  const bricks::csv_reader<int, long> reader{',', true};
+  const auto sequential = reader.parse(input).unwrap();
+  REQUIRE(std::get<0>(sequential).size() == 5000);
+  for (const std::size_t chunks : {1, 2, 3, 8, 64, 10000}) {
+    CAPTURE(chunks);
+    auto parsed = reader.parse(input, chunks);
+    REQUIRE(parsed.is_value());
+    CHECK(parsed.unwrap() == sequential);
+  }
+
+  input += "oops,1\n";
+  for (const std::size_t chunks : {1, 4, 7}) {
+    auto parsed = reader.parse(input, chunks);
+    REQUIRE(parsed.is_error());
+    CHECK(parsed.unwrap_error() == bricks::csv_error{5000, 0, std::errc::invalid_argument});
+  }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,272 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <bricks/encoding.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace {
+
+auto random_bytes(std::size_t size, std::mt19937& rng) -> std::string
+{
+  std::uniform_int_distribution<int> byte{0, 255};
+  std::string bytes(size, '\0');
+  for (auto& c : bytes) {
+    c = static_cast<char>(byte(rng));
+  }
+  return bytes;
+}
+
+auto reference_hex(const std::string& bytes) -> std::string
+{
+  constexpr const char* digits = "0123456789abcdef";
+  std::string hex;
+  for (const char c : bytes) {
+    const auto b = static_cast<unsigned char>(c);
+    hex += digits[b >> 4U];
+    hex += digits[b & 0x0fU];
+  }
+  return hex;
+}
+
+auto reference_base64_decode(const std::string& encoded, std::string_view chars) -> std::string
+{
+  std::string bytes;
+  std::uint32_t bits = 0;
+  unsigned count = 0;
+  for (const char c : encoded) {
+    bits = (bits << 6U) | static_cast<std::uint32_t>(chars.find(c));
+    count += 6;
+    if (count >= 8) {
+      count -= 8;
+      bytes += static_cast<char>((bits >> count) & 0xffU);
+    }
+  }
+  return bytes;
+}
+
+auto random_base64(std::size_t size, std::string_view chars, std::mt19937& rng) -> std::string
+{
+  std::uniform_int_distribution<std::size_t> index{0, chars.size() - 1};
+  std::string encoded(size, '\0');
+  for (auto& c : encoded) {
+    c = chars[index(rng)];
+  }
+  return encoded;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("[encoding]");
+
+TEST_CASE("to_hex example")
+{
+  /// [to_hex-example]
+  CHECK(bricks::to_hex("\x01\xab\xff") == "01abff");
+
+  auto bytes = bricks::from_hex("01ABff");
+  REQUIRE(bytes.is_value());
+  CHECK(bytes.unwrap() == "\x01\xab\xff");
+  /// [to_hex-example]
+}
+
+TEST_CASE("base64 example")
+{
+  /// [base64-example]
+  CHECK(bricks::base64_encode("hello") == "aGVsbG8=");
+  CHECK(bricks::base64_encode("\xfb\xff", bricks::base64_alphabet::url) == "-_8");
+
+  auto bytes = bricks::base64_decode("aGVsbG8=");
+  REQUIRE(bytes.is_value());
+  CHECK(bytes.unwrap() == "hello");
+  /// [base64-example]
+}
+
+TEST_CASE("base32 example")
+{
+  /// [base32-example]
+  CHECK(bricks::base32_encode("hello") == "NBSWY3DP");
+
+  auto bytes = bricks::base32_decode("MZXW6===");
+  REQUIRE(bytes.is_value());
+  CHECK(bytes.unwrap() == "foo");
+  /// [base32-example]
+}
+
+TEST_CASE("RFC 4648 test vectors")
+{
+  const std::array<std::array<const char*, 4>, 7> vectors{{
+      {"", "", "", ""},
+      {"f", "Zg==", "MY======", "66"},
+      {"fo", "Zm8=", "MZXQ====", "666f"},
+      {"foo", "Zm9v", "MZXW6===", "666f6f"},
+      {"foob", "Zm9vYg==", "MZXW6YQ=", "666f6f62"},
+      {"fooba", "Zm9vYmE=", "MZXW6YTB", "666f6f6261"},
+      {"foobar", "Zm9vYmFy", "MZXW6YTBOI======", "666f6f626172"},
+  }};
+
+  for (const auto& [plain, base64, base32, hex] : vectors) {
+    CHECK(bricks::base64_encode(plain) == base64);
+    CHECK(bricks::base64_decode(base64).unwrap_or("") == plain);
+    CHECK(bricks::base32_encode(plain) == base32);
+    CHECK(bricks::base32_decode(base32).unwrap_or("") == plain);
+    CHECK(bricks::to_hex(plain) == hex);
+    CHECK(bricks::from_hex(hex).unwrap_or("") == plain);
+  }
+}
+
+TEST_CASE("Vectorized kernels match the scalar encoding")
+{
+  std::mt19937 rng{42};
+  for (std::size_t size = 0; size < 200; size += 7) {
+    const auto bytes = random_bytes(size, rng);
+    CAPTURE(size);
+
+    const auto hex = bricks::to_hex(bytes);
+    CHECK(hex == reference_hex(bytes));
+    CHECK(bricks::from_hex(hex).unwrap_or("") == bytes);
+
+    for (const auto alphabet : {bricks::base64_alphabet::standard, bricks::base64_alphabet::url}) {
+      const auto base64 = bricks::base64_encode(bytes, alphabet);
+      CHECK(base64.size() == bricks::base64_encoded_size(size, alphabet));
+      CHECK(bricks::base64_decode(base64, alphabet).unwrap_or("") == bytes);
+    }
+  }
+}
+
+TEST_CASE("Vectorized kernels match the scalar base64 decoding")
+{
+  std::mt19937 rng{7};
+  for (const auto alphabet : {bricks::base64_alphabet::standard, bricks::base64_alphabet::url}) {
+    const auto chars = bricks::detail::base64_chars(alphabet);
+    for (std::size_t size = 0; size < 300; size += 4) {
+      CAPTURE(size);
+      const auto encoded = random_base64(size, chars, rng);
+      const auto expected = reference_base64_decode(encoded, chars);
+      CHECK(bricks::base64_decode(encoded, alphabet).unwrap_or("") == expected);
+
+      const auto check_kernel = [&](auto kernel) {
+        std::string decoded(expected.size(), '\0');
+        auto* out = reinterpret_cast<unsigned char*>(decoded.data());  // NOLINT
+        const auto consumed = kernel(encoded.data(), encoded.size(), out, chars[62], chars[63]);
+        CHECK(consumed == size / 16 * 16);
+        CHECK(decoded.compare(0, consumed / 4 * 3, expected, 0, consumed / 4 * 3) == 0);
+      };
+      const auto& features = bricks::cpu_features::current();
+      if (features.ssse3) check_kernel(bricks::detail::base64_decode_ssse3);
+      if (features.avx2) check_kernel(bricks::detail::base64_decode_avx2);
+
+      if (size == 0) continue;
+      auto invalid = encoded;
+      invalid[std::uniform_int_distribution<std::size_t>{0, size - 1}(rng)] = '!';
+      CHECK(bricks::base64_decode(invalid, alphabet).is_error());
+    }
+  }
+}
+
+TEST_CASE("The URL alphabet is unpadded and uses - and _")
+{
+  const std::string bytes = "\xfb\xef\xbe\xfb\xef";
+  CHECK(bricks::base64_encode(bytes) == "++++++8=");
+  CHECK(bricks::base64_encode(bytes, bricks::base64_alphabet::url) == "------8");
+  CHECK(bricks::base64_decode("------8=", bricks::base64_alphabet::url).unwrap_or("") == bytes);
+  CHECK(bricks::base64_decode("++++++8").unwrap_or("") == bytes);
+}
+
+TEST_CASE("Decoding invalid input fails")
+{
+  const auto check_invalid = [](const bricks::result<std::string, std::errc>& decoded) {
+    REQUIRE(decoded.is_error());
+    CHECK(decoded.unwrap_error() == std::errc::invalid_argument);
+  };
+
+  check_invalid(bricks::from_hex("abc"));
+  check_invalid(bricks::from_hex("zz"));
+  check_invalid(bricks::from_hex("00112233445566778899aabbccddeefg"));
+  check_invalid(bricks::base64_decode("Zm9v!"));
+  check_invalid(bricks::base64_decode("Z"));
+  check_invalid(bricks::base64_decode("Zg=="
+                                      "Zg=="));
+  check_invalid(bricks::base64_decode("Zg="));
+  check_invalid(bricks::base64_decode("+/+/", bricks::base64_alphabet::url));
+  check_invalid(bricks::base64_decode("-_-_"));
+  check_invalid(bricks::base32_decode("MZXW6==="
+                                      "1"));
+  check_invalid(bricks::base32_decode("MZX"));
+}
+
+TEST_CASE("Decoding rejects non-zero trailing bits")
+{
+  CHECK(bricks::base64_decode("Zg==").unwrap_or("") == "f");
+  CHECK(bricks::base64_decode("Zh==").is_error());
+  CHECK(bricks::base64_decode("Zm9=").is_error());
+  CHECK(bricks::base64_decode("Zh", bricks::base64_alphabet::url).is_error());
+  CHECK(bricks::base64_decode("Zm9vYmFyZh==").is_error());
+
+  CHECK(bricks::base32_decode("MY======").unwrap_or("") == "f");
+  CHECK(bricks::base32_decode("MZ======").is_error());
+  CHECK(bricks::base32_decode("MZXW6YTBOJ======").is_error());
+}
+
+TEST_CASE("Buffer variants check the buffer size")
+{
+  std::array<char, 8> buffer{};
+  char* first = buffer.data();
+  char* last = buffer.data() + buffer.size();
+
+  auto end = bricks::to_hex("abcd", first, last);
+  REQUIRE(end.is_value());
+  CHECK(std::string(first, end.unwrap_or(first)) == "61626364");
+
+  end = bricks::to_hex("abcde", first, last);
+  REQUIRE(end.is_error());
+  CHECK(end.unwrap_error() == std::errc::value_too_large);
+
+  end = bricks::base64_decode("aGVsbG8=", first, last);
+  REQUIRE(end.is_value());
+  CHECK(std::string(first, end.unwrap_or(first)) == "hello");
+
+  end = bricks::base64_encode("hello", first, last);
+  REQUIRE(end.is_value());
+  CHECK(std::string(first, end.unwrap_or(first)) == "aGVsbG8=");
+
+  end = bricks::base32_encode("hello!", first, last);
+  REQUIRE(end.is_error());
+  CHECK(end.unwrap_error() == std::errc::value_too_large);
+
+  end = bricks::from_hex("0102030405060708090a", first, last);
+  REQUIRE(end.is_error());
+  CHECK(end.unwrap_error() == std::errc::value_too_large);
+
+  end = bricks::from_hex("0x", first, last);
+  REQUIRE(end.is_error());
+  CHECK(end.unwrap_error() == std::errc::invalid_argument);
+}
+
+TEST_CASE("Append variants append and keep the string on error")
+{
+  std::string out = "id=";
+  CHECK(bricks::append_hex(out, "\x10") == 2);
+  CHECK(out == "id=10");
+
+  CHECK(bricks::append_base64_encode(out, "a") == 4);
+  CHECK(out == "id=10YQ==");
+
+  auto appended = bricks::append_base32_decode(out, "MZXW6===");
+  REQUIRE(appended.is_value());
+  CHECK(appended.unwrap() == 3);
+  CHECK(out == "id=10YQ==foo");
+
+  appended = bricks::append_from_hex(out, "0g");
+  REQUIRE(appended.is_error());
+  CHECK(out == "id=10YQ==foo");
+
+  appended = bricks::append_base64_decode(out, "!!!!");
+  REQUIRE(appended.is_error());
+  CHECK(out == "id=10YQ==foo");
+}
+
+TEST_SUITE_END();
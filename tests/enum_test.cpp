@@ -0,0 +1,131 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <bricks/charconv.hpp>
+#include <bricks/enum.hpp>
+#include <cstdint>
+#include <string>
+
+/// [enum_traits-declaration]
+enum class color { red, green, blue };
+
+template <>
+struct bricks::enum_traits<color> {
+  static constexpr std::array<bricks::enum_entry<color>, 3> entries{{
+      {color::red, "red"},
+      {color::green, "green"},
+      {color::blue, "blue"},
+  }};
+};
+/// [enum_traits-declaration]
+
+namespace {
+
+enum class status : std::int16_t { failed = -1, pending = 10, done = 200 };
+
+enum class opcode : std::uint8_t {
+  nop,
+  load,
+  store,
+  add,
+  sub,
+  mul,
+  div,
+  jump,
+  call,
+  ret,
+  push,
+  pop,
+  cmp,
+  jeq,
+  jne,
+  halt,
+};
+
+}  // namespace
+
+template <>
+struct bricks::enum_traits<status> {
+  static constexpr std::array<bricks::enum_entry<status>, 3> entries{{
+      {status::failed, "failed"},
+      {status::pending, "pending"},
+      {status::done, "done"},
+  }};
+};
+
+template <>
+struct bricks::enum_traits<opcode> {
+  static constexpr std::array<bricks::enum_entry<opcode>, 16> entries{{
+      {opcode::nop, "nop"},   {opcode::load, "load"}, {opcode::store, "store"},
+      {opcode::add, "add"},   {opcode::sub, "sub"},   {opcode::mul, "mul"},
+      {opcode::div, "div"},   {opcode::jump, "jump"}, {opcode::call, "call"},
+      {opcode::ret, "ret"},   {opcode::push, "push"}, {opcode::pop, "pop"},
+      {opcode::cmp, "cmp"},   {opcode::jeq, "jeq"},   {opcode::jne, "jne"},
+      {opcode::halt, "halt"},
+  }};
+};
+
+TEST_SUITE_BEGIN("[enum]");
+
+TEST_CASE("enum_traits example")
+{
+  /// [enum_traits-example]
+  auto name = bricks::enum_to_string(color::green);
+  REQUIRE(name.is_value());
+  CHECK(name.unwrap() == "green");
+
+  auto value = bricks::enum_from_string<color>("blue");
+  REQUIRE(value.is_value());
+  CHECK(value.unwrap() == color::blue);
+  /// [enum_traits-example]
+}
+
+TEST_CASE("Can detect enum_traits")
+{
+  enum class unnamed { a };
+  CHECK(bricks::has_enum_traits_v<color>);
+  CHECK_FALSE(bricks::has_enum_traits_v<unnamed>);
+}
+
+TEST_CASE("Round-trips every enumerator")
+{
+  for (const auto& entry : bricks::enum_traits<opcode>::entries) {
+    CHECK(bricks::enum_to_string(entry.value).unwrap_or("") == entry.name);
+    CHECK(bricks::enum_from_string<opcode>(entry.name).unwrap_or(opcode::nop) == entry.value);
+  }
+  for (const auto& entry : bricks::enum_traits<status>::entries) {
+    CHECK(bricks::enum_to_string(entry.value).unwrap_or("") == entry.name);
+    CHECK(bricks::enum_from_string<status>(entry.name).unwrap_or(status::pending) == entry.value);
+  }
+}
+
+TEST_CASE("Unknown names and values are errors")
+{
+  const auto check_invalid = [](const auto& converted) {
+    REQUIRE(converted.is_error());
+    CHECK(converted.unwrap_error() == std::errc::invalid_argument);
+  };
+
+  check_invalid(bricks::enum_from_string<color>("purple"));
+  check_invalid(bricks::enum_from_string<color>("Red"));
+  check_invalid(bricks::enum_from_string<color>(""));
+  check_invalid(bricks::enum_from_string<opcode>("loads"));
+  check_invalid(bricks::enum_to_string(static_cast<color>(3)));
+  check_invalid(bricks::enum_to_string(static_cast<color>(-1)));
+  check_invalid(bricks::enum_to_string(static_cast<status>(0)));
+}
+
+TEST_CASE("Works with to_string and from_string")
+{
+  auto name = bricks::to_string(status::done);
+  REQUIRE(name.is_value());
+  CHECK(name.unwrap() == "done");
+
+  auto value = bricks::from_string<status>("failed");
+  REQUIRE(value.is_value());
+  CHECK(value.unwrap() == status::failed);
+
+  CHECK(bricks::from_string<status>("42").is_error());
+}
+
+TEST_SUITE_END();
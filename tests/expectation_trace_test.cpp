@@ -0,0 +1,110 @@
+#include <doctest/doctest.h>
+
+#include <bricks/expectation_trace.hpp>
+#include <bricks/result.hpp>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("[expectation_trace]");
+
+TEST_CASE("expectation_trace example")
+{
+  /// [expectation_trace-example]
+  auto& trace = bricks::expectation_trace::global();
+  trace.clear();
+
+  const bricks::result<int, std::string> res{"error"};
+  try {
+    [[maybe_unused]] const auto value = res.expect("The config must be loaded.");
+  } catch (const bricks::bad_result_access&) {
+    // Swallowed, but still traced.
+  }
+
+  const auto recent = trace.recent();
+  REQUIRE(recent.size() == 1);
+  CHECK(recent.front().message() == "The config must be loaded.");
+  CHECK(recent.front().location().line() > 0);
+  /// [expectation_trace-example]
+}
+
+TEST_CASE("source_location captures the caller")
+{
+  const auto here = [](bricks::source_location location = bricks::source_location::current()) {
+    return location;
+  };
+  const auto line = __LINE__ + 1;
+  const auto location = here();
+  CHECK(location.line() == line);
+  CHECK(std::string_view{location.file_name()}.find("expectation_trace_test.cpp") !=
+        std::string_view::npos);
+}
+
+TEST_CASE("expectation_trace keeps the most recent entries")
+{
+  bricks::expectation_trace trace;
+  const auto location = bricks::source_location::current();
+  for (std::size_t i = 0; i < bricks::expectation_trace::capacity + 5; ++i) {
+    trace.record(location, std::to_string(i));
+  }
+
+  CHECK(trace.size() == bricks::expectation_trace::capacity + 5);
+  const auto recent = trace.recent();
+  REQUIRE(recent.size() == bricks::expectation_trace::capacity);
+  CHECK(recent.front().message() == "5");
+  CHECK(recent.back().message() == std::to_string(bricks::expectation_trace::capacity + 4));
+  for (std::size_t i = 1; i < recent.size(); ++i) {
+    CHECK(recent[i].sequence() == recent[i - 1].sequence() + 1);
+  }
+
+  trace.clear();
+  CHECK(trace.size() == 0);
+  CHECK(trace.recent().empty());
+}
+
+TEST_CASE("expectation_trace truncates long messages")
+{
+  bricks::expectation_trace trace;
+  const std::string message(200, 'm');
+  trace.record(bricks::source_location::current(), message);
+  const auto recent = trace.recent();
+  REQUIRE(recent.size() == 1);
+  CHECK(recent.front().message() ==
+        std::string_view{message}.substr(0, bricks::failed_expectation::max_message_size));
+}
+
+TEST_CASE("expectation_trace records from many threads")
+{
+  bricks::expectation_trace trace;
+  constexpr int threads = 4;
+  constexpr int per_thread = 1000;
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&trace, t] {
+      for (int i = 0; i < per_thread; ++i) {
+        trace.record(bricks::source_location::current(), std::to_string(t));
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  CHECK(trace.size() == threads * per_thread);
+  const auto recent = trace.recent();
+  REQUIRE(recent.size() == bricks::expectation_trace::capacity);
+  std::set<std::uint64_t> sequences;
+  for (const auto& entry : recent) {
+    sequences.insert(entry.sequence());
+    CHECK(entry.message().size() == 1);
+  }
+  CHECK(sequences.size() == recent.size());
+  // Every slot keeps the newest of the failures mapped to it, however the writers interleaved.
+  CHECK(*sequences.begin() == threads * per_thread - bricks::expectation_trace::capacity);
+  CHECK(*sequences.rbegin() == threads * per_thread - 1);
+}
+
+TEST_SUITE_END();
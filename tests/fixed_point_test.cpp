@@ -0,0 +1,106 @@
+#include <doctest/doctest.h>
+
+#include <bricks/fixed_point.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+TEST_SUITE_BEGIN("[fixed_point]");
+
+TEST_CASE("from_string_fixed example")
+{
+  /// [from_string_fixed-example]
+  auto price = bricks::from_string_fixed<4>("1234.5678");
+  REQUIRE(price.is_value());
+  CHECK(price.unwrap() == 12345678);
+
+  CHECK(bricks::from_string_fixed<4>("-0.5").unwrap_or(0) == -5000);
+  CHECK(bricks::from_string_fixed<4>("42").unwrap_or(0) == 420000);
+  /// [from_string_fixed-example]
+}
+
+TEST_CASE("to_string_fixed example")
+{
+  /// [to_string_fixed-example]
+  CHECK(bricks::to_string_fixed<4>(12345678) == "1234.5678");
+  CHECK(bricks::to_string_fixed<4>(-100) == "-0.0100");
+  CHECK(bricks::to_string_fixed<0>(42) == "42");
+  /// [to_string_fixed-example]
+}
+
+TEST_CASE("from_string_fixed pads missing fractional digits")
+{
+  CHECK(bricks::from_string_fixed<8>("1.5").unwrap_or(0) == 150000000);
+  CHECK(bricks::from_string_fixed<2>("0.05").unwrap_or(0) == 5);
+  CHECK(bricks::from_string_fixed<2>("-0").unwrap_or(1) == 0);
+}
+
+TEST_CASE("from_string_fixed uses the eight digit path")
+{
+  CHECK(bricks::from_string_fixed<0>("1234567890123456").unwrap_or(0) == 1234567890123456);
+  CHECK(bricks::from_string_fixed<10>("12345678.1234567890").unwrap_or(0) ==
+        123456781234567890);
+  CHECK(bricks::from_string_fixed<9>("00000000.000000001").unwrap_or(0) == 1);
+}
+
+TEST_CASE("from_string_fixed accepts trailing zeros beyond the scale")
+{
+  CHECK(bricks::from_string_fixed<2>("1.2500000000").unwrap_or(0) == 125);
+  CHECK(bricks::from_string_fixed<0>("7.0").unwrap_or(0) == 7);
+}
+
+TEST_CASE("from_string_fixed with invalid input")
+{
+  const char* input = "";
+  SUBCASE("empty") { input = ""; }
+  SUBCASE("sign only") { input = "-"; }
+  SUBCASE("plus sign") { input = "+1"; }
+  SUBCASE("no integer digits") { input = ".5"; }
+  SUBCASE("no fractional digits") { input = "1."; }
+  SUBCASE("letters") { input = "12a4"; }
+  SUBCASE("letters in an eight digit block") { input = "1234567x90"; }
+  SUBCASE("second point") { input = "1.2.3"; }
+  SUBCASE("significant digit beyond the scale") { input = "1.23456"; }
+
+  auto value = bricks::from_string_fixed<4>(input);
+  REQUIRE(value.is_error());
+  CHECK(value.unwrap_error() == std::errc::invalid_argument);
+}
+
+TEST_CASE("from_string_fixed detects overflow")
+{
+  CHECK(bricks::from_string_fixed<0>("9223372036854775807").unwrap_or(0) ==
+        std::numeric_limits<std::int64_t>::max());
+  CHECK(bricks::from_string_fixed<0>("-9223372036854775808").unwrap_or(0) ==
+        std::numeric_limits<std::int64_t>::min());
+  CHECK(bricks::from_string_fixed<4>("-922337203685477.5808").unwrap_or(0) ==
+        std::numeric_limits<std::int64_t>::min());
+
+  bricks::result<std::int64_t, std::errc> value{0};
+  SUBCASE("integer part") { value = bricks::from_string_fixed<0>("9223372036854775808"); }
+  SUBCASE("negative integer part") { value = bricks::from_string_fixed<0>("-9223372036854775809"); }
+  SUBCASE("many digits") { value = bricks::from_string_fixed<0>("123456789012345678901234567890"); }
+  SUBCASE("scaled") { value = bricks::from_string_fixed<4>("922337203685478"); }
+  SUBCASE("fraction") { value = bricks::from_string_fixed<4>("922337203685477.5808"); }
+
+  REQUIRE(value.is_error());
+  CHECK(value.unwrap_error() == std::errc::result_out_of_range);
+}
+
+TEST_CASE("to_string_fixed round-trips")
+{
+  for (const std::int64_t value :
+       {std::int64_t{0}, std::int64_t{1}, std::int64_t{-1}, std::int64_t{10000},
+        std::int64_t{123456789}, std::numeric_limits<std::int64_t>::max(),
+        std::numeric_limits<std::int64_t>::min()}) {
+    CHECK(bricks::from_string_fixed<4>(bricks::to_string_fixed<4>(value)).unwrap_or(0) == value);
+    CHECK(bricks::from_string_fixed<0>(bricks::to_string_fixed<0>(value)).unwrap_or(0) == value);
+    CHECK(bricks::from_string_fixed<18>(bricks::to_string_fixed<18>(value)).unwrap_or(0) ==
+          value);
+  }
+  CHECK(bricks::to_string_fixed<18>(std::numeric_limits<std::int64_t>::min()) ==
+        "-9.223372036854775808");
+  CHECK(bricks::to_string_fixed<2>(5) == "0.05");
+}
+
+TEST_SUITE_END();
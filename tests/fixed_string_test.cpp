@@ -0,0 +1,91 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <bricks/fixed_string.hpp>
+#include <bricks/format.hpp>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+TEST_SUITE_BEGIN("[fixed_string]");
+
+TEST_CASE("fixed_string example")
+{
+  /// [fixed_string-example]
+  constexpr bricks::fixed_string<8> name{"bricks"};
+  static_assert(name.size() == 6);
+  static_assert(name.capacity() == 8);
+
+  const std::string_view view = name;
+  CHECK(view == "bricks");
+  CHECK(name == "bricks");
+  /// [fixed_string-example]
+}
+
+TEST_CASE("Default constructed fixed_string is empty")
+{
+  const bricks::fixed_string<4> str;
+  CHECK(str.empty());
+  CHECK(str.size() == 0);
+  CHECK(str.c_str()[0] == '\0');
+  CHECK(str.begin() == str.end());
+}
+
+TEST_CASE("Can deduce the capacity from a literal")
+{
+  constexpr bricks::fixed_string str{"abc"};
+  static_assert(decltype(str)::capacity() == 3);
+  CHECK(str == "abc");
+}
+
+TEST_CASE("Can construct from a string_view")
+{
+  const bricks::fixed_string<5> str{std::string_view{"hello"}};
+  CHECK(str == "hello");
+  CHECK(std::string{str.c_str()} == "hello");
+
+  CHECK_THROWS_AS(bricks::fixed_string<4>{std::string_view{"hello"}}, std::length_error);
+}
+
+TEST_CASE("Can write into the buffer and resize")
+{
+  bricks::fixed_string<8> str;
+  std::fill_n(str.data(), 3, 'x');
+  str.resize(3);
+  CHECK(str == "xxx");
+  CHECK(str.c_str()[3] == '\0');
+
+  str.resize(1);
+  CHECK(str == "x");
+  CHECK(str.c_str()[1] == '\0');
+
+  CHECK_THROWS_AS(str.resize(9), std::length_error);
+}
+
+TEST_CASE("Can iterate and index")
+{
+  bricks::fixed_string<4> str{"abcd"};
+  str[0] = 'z';
+  CHECK(std::string(str.begin(), str.end()) == "zbcd");
+  CHECK(str[3] == 'd');
+}
+
+TEST_CASE("Can compare fixed_strings of different capacity")
+{
+  constexpr bricks::fixed_string<3> lhs{"ab"};
+  constexpr bricks::fixed_string<5> rhs{"ab"};
+  static_assert(lhs == rhs);
+  static_assert(lhs != bricks::fixed_string<5>{"abc"});
+  CHECK(std::string{"ab"} == lhs);
+  CHECK(lhs != "abc");
+}
+
+TEST_CASE("Can be used as a format argument")
+{
+  std::string out;
+  const bricks::fixed_string<8> name{"world"};
+  REQUIRE(bricks::format_to(out, BRICKS_FORMAT_STRING("hello {}"), name).is_value());
+  CHECK(out == "hello world");
+}
+
+TEST_SUITE_END();
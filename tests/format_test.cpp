@@ -0,0 +1,205 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <bricks/alloc_tracker.hpp>
+#include <bricks/format.hpp>
+#include <bricks/ranges.hpp>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+TEST_SUITE_BEGIN("[format]");
+
+TEST_CASE("format_to example")
+{
+  /// [format_to-example]
+  std::string line;
+  auto written =
+      bricks::format_to(line, BRICKS_FORMAT_STRING("user={} id={} ok={}"), "alice", 42, true);
+
+  REQUIRE(written.is_value());
+  CHECK(written.unwrap() == line.size());
+  CHECK(line == "user=alice id=42 ok=true");
+  /// [format_to-example]
+}
+
+TEST_CASE("format_to buffer example")
+{
+  /// [format_to-buffer-example]
+  std::array<char, 16> buffer{};
+  auto written = bricks::format_to(buffer.data(), buffer.data() + buffer.size(),
+                                   BRICKS_FORMAT_STRING("{}:{}"), "key", 7);
+
+  REQUIRE(written.is_value());
+  CHECK(std::string_view{buffer.data(), written.unwrap()} == "key:7");
+  /// [format_to-buffer-example]
+}
+
+TEST_CASE("format_to appends")
+{
+  std::string out = "prefix ";
+  REQUIRE(bricks::format_to(out, BRICKS_FORMAT_STRING("{}"), 1).is_value());
+  CHECK(out == "prefix 1");
+}
+
+TEST_CASE_TEMPLATE("format_to with integer limits", T, std::int8_t, std::uint8_t, short,
+                   unsigned short, int, unsigned, long, unsigned long, long long,
+                   unsigned long long)
+{
+  std::string out;
+  REQUIRE(bricks::format_to(out, BRICKS_FORMAT_STRING("{} {} {}"), std::numeric_limits<T>::min(),
+                            T{0}, std::numeric_limits<T>::max())
+              .is_value());
+  CHECK(out == std::to_string(std::numeric_limits<T>::min()) + " 0 " +
+                   std::to_string(std::numeric_limits<T>::max()));
+}
+
+TEST_CASE("format_to with every digit count")
+{
+  std::uint64_t value = 1;
+  for (int digits = 1; digits <= 20; ++digits) {
+    std::string out;
+    REQUIRE(bricks::format_to(out, BRICKS_FORMAT_STRING("{}"), value).is_value());
+    CHECK(out == std::to_string(value));
+    CHECK(out.size() == static_cast<std::size_t>(digits));
+    value = digits < 19 ? value * 10 : std::numeric_limits<std::uint64_t>::max();
+  }
+}
+
+TEST_CASE("format_to with other argument types")
+{
+  std::string out;
+  const std::string str = "string";
+  REQUIRE(bricks::format_to(out, BRICKS_FORMAT_STRING("{}|{}|{}|{}|{}|{}"), 0.5, -1.25F, 'c', false,
+                            str, std::string_view{"view"})
+              .is_value());
+  CHECK(out == "0.5|-1.25|c|false|string|view");
+}
+
+TEST_CASE("format_to with escaped braces")
+{
+  std::string out;
+  REQUIRE(bricks::format_to(out, BRICKS_FORMAT_STRING("{{{}}} }}{{"), 1).is_value());
+  CHECK(out == "{1} }{");
+}
+
+TEST_CASE("format_to without placeholders")
+{
+  std::string out;
+  auto written = bricks::format_to(out, BRICKS_FORMAT_STRING("plain"));
+  REQUIRE(written.is_value());
+  CHECK(written.unwrap() == 5);
+  CHECK(out == "plain");
+}
+
+TEST_CASE("format_to into a reserved string allocates nothing")
+{
+  std::string out;
+  out.reserve(64);
+  const bricks::allocation_counter counter;
+  REQUIRE(bricks::format_to(out, BRICKS_FORMAT_STRING("{}-{}-{}"), 123456789, 2.5, "a rather long "
+                                                                                   "string field")
+              .is_value());
+  CHECK(counter.allocations() == 0);
+}
+
+TEST_CASE("format_to fails if the buffer is too small")
+{
+  std::array<char, 4> buffer{'x', 'x', 'x', 'x'};
+  auto written = bricks::format_to(buffer.data(), buffer.data() + buffer.size(),
+                                   BRICKS_FORMAT_STRING("{}"), 12345);
+  REQUIRE(written.is_error());
+  CHECK(written.unwrap_error() == std::errc::value_too_large);
+  CHECK(buffer[0] == 'x');
+}
+
+TEST_CASE("join_to example")
+{
+  /// [join_to-example]
+  const std::vector<int> numbers{1, 2, 3};
+  std::string out;
+  auto written = bricks::join_to(out, numbers, ",");
+
+  REQUIRE(written.is_value());
+  CHECK(written.unwrap() == 5);
+  CHECK(out == "1,2,3");
+  /// [join_to-example]
+}
+
+TEST_CASE("join_to with empty and single element ranges")
+{
+  std::string out = "x";
+  REQUIRE(bricks::join_to(out, std::vector<int>{}, ", ").is_value());
+  CHECK(out == "x");
+  REQUIRE(bricks::join_to(out, std::vector<int>{-7}, ", ").is_value());
+  CHECK(out == "x-7");
+}
+
+TEST_CASE("join_to with mixed element types")
+{
+  std::string out;
+  REQUIRE(bricks::join_to(out, std::vector<double>{0.5, -2.0, 1e300}, " ").is_value());
+  CHECK(out == "0.5 -2 1e+300");
+
+  out.clear();
+  REQUIRE(bricks::join_to(out, std::vector<std::string>{"a", "", "bc"}, "|").is_value());
+  CHECK(out == "a||bc");
+}
+
+TEST_CASE("join_to with views")
+{
+  std::vector<int> numbers{1, 2, 3, 4, 5, 6};
+  std::vector<std::string> names{"one", "two", "three"};
+
+  std::string out;
+  REQUIRE(bricks::join_to(out, bricks::filter(numbers, [](int n) { return n % 2 == 0; }), ",")
+              .is_value());
+  CHECK(out == "2,4,6");
+
+  out.clear();
+  REQUIRE(bricks::join_to(out, bricks::zip(numbers, names), ", ", "=").is_value());
+  CHECK(out == "1=one, 2=two, 3=three");
+
+  out.clear();
+  REQUIRE(bricks::join_to(out, bricks::enumerate(names), " ").is_value());
+  CHECK(out == "0:one 1:two 2:three");
+}
+
+TEST_CASE("join_to into a reserved string allocates nothing")
+{
+  std::vector<std::uint64_t> numbers(100);
+  for (std::size_t i = 0; i < numbers.size(); ++i) {
+    numbers[i] = i * 1234567;
+  }
+  std::string expected;
+  for (const auto n : numbers) {
+    expected += (expected.empty() ? "" : ",") + std::to_string(n);
+  }
+
+  std::string out;
+  out.reserve(expected.size());
+  const bricks::allocation_counter counter;
+  auto written = bricks::join_to(out, numbers, ",");
+  CHECK(counter.allocations() == 0);
+  REQUIRE(written.is_value());
+  CHECK(written.unwrap() == expected.size());
+  CHECK(out == expected);
+}
+
+TEST_CASE("join_to fails if the buffer is too small")
+{
+  std::array<char, 4> buffer{'x', 'x', 'x', 'x'};
+  const std::vector<int> numbers{10, 20};
+  auto written = bricks::join_to(buffer.data(), buffer.data() + buffer.size(), numbers, ",");
+  REQUIRE(written.is_error());
+  CHECK(written.unwrap_error() == std::errc::value_too_large);
+  CHECK(buffer[0] == 'x');
+
+  std::array<char, 5> exact{};
+  written = bricks::join_to(exact.data(), exact.data() + exact.size(), numbers, ",");
+  REQUIRE(written.is_value());
+  CHECK(std::string_view{exact.data(), written.unwrap()} == "10,20");
+}
+
+TEST_SUITE_END();
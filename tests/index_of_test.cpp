@@ -1,12 +1,15 @@
 #include <doctest/doctest.h>
 
 #include <bricks/algorithm.hpp>
+#include <cstdint>
 #include <list>
 #include <map>
+#include <numeric>
 #include <set>
 #include <stdexcept>
 #include <string>
 #include <unordered_set>
+#include <vector>
 
 #include "string_makers.hpp"
 
@@ -67,6 +70,39 @@ TEST_CASE("index_of")
     CHECK(bricks::index_of(s, 'c') == 2);
     CHECK(bricks::index_of(s, 'd') == std::nullopt);
   }
+
+  SUBCASE("contiguous integers at every position")
+  {
+    std::vector<std::int16_t> v(100);
+    std::iota(v.begin(), v.end(), std::int16_t{-50});
+    for (std::size_t i = 0; i < v.size(); ++i) {
+      CHECK(bricks::index_of(v, v[i]) == i);
+    }
+    CHECK(bricks::index_of(v, std::int16_t{50}) == std::nullopt);
+
+    std::vector<std::uint64_t> wide(33, 7);
+    wide[32] = 8;
+    CHECK(bricks::index_of(wide, std::uint64_t{8}) == 32);
+    CHECK(bricks::index_of(wide, std::uint64_t{7} | (std::uint64_t{1} << 32U)) == std::nullopt);
+  }
+
+  SUBCASE("bytes, enumerations and pointers")
+  {
+    std::vector<char> chars(40, 'a');
+    chars[37] = 'b';
+    CHECK(bricks::index_of(chars, 'b') == 37);
+    CHECK(bricks::index_of(chars, 'c') == std::nullopt);
+
+    enum class level : std::uint16_t { low, high };
+    std::vector<level> levels(20, level::low);
+    levels[17] = level::high;
+    CHECK(bricks::index_of(levels, level::high) == 17);
+
+    std::vector<const int*> pointers(9, nullptr);
+    const int value = 0;
+    pointers[8] = &value;
+    CHECK(bricks::index_of(pointers, &value) == 8);
+  }
 }
 
 TEST_CASE("index_of_if")
@@ -0,0 +1,77 @@
+#include <doctest/doctest.h>
+
+#include <bricks/perf_counters.hpp>
+#include <numeric>
+#include <vector>
+
+TEST_SUITE_BEGIN("[perf_counters]");
+
+TEST_CASE("example")
+{
+  /// [perf_counters-example]
+  const bricks::perf_counters counters;
+
+  std::vector<int> values(1000, 1);
+  bricks::perf_sample sample;
+  {
+    const auto region = counters.measure(sample);
+    INFO(std::accumulate(values.begin(), values.end(), 0));
+  }
+
+  INFO("instructions: ", sample.instructions, ", IPC: ", sample.ipc());
+  /// [perf_counters-example]
+  if (counters.available()) {
+    CHECK(sample.instructions > 0);
+    CHECK(sample.cycles > 0);
+  }
+}
+
+TEST_CASE("readings are zero if counters are unavailable")
+{
+  const bricks::perf_counters counters;
+  if (counters.available()) return;
+
+  const auto sample = counters.read();
+  CHECK(sample.cycles == 0);
+  CHECK(sample.instructions == 0);
+  CHECK(sample.cache_misses == 0);
+  CHECK(sample.branch_misses == 0);
+  CHECK(sample.ipc() == 0.0);
+}
+
+TEST_CASE("readings are monotonic")
+{
+  const bricks::perf_counters counters;
+  const auto first = counters.read();
+  const auto second = counters.read();
+  CHECK(second.cycles >= first.cycles);
+  CHECK(second.instructions >= first.instructions);
+}
+
+TEST_CASE("moved counters keep counting")
+{
+  bricks::perf_counters counters;
+  const auto was_available = counters.available();
+
+  bricks::perf_counters moved{std::move(counters)};
+  CHECK(moved.available() == was_available);
+  CHECK_FALSE(counters.available());  // NOLINT(bugprone-use-after-move)
+}
+
+TEST_CASE("sample arithmetic")
+{
+  constexpr bricks::perf_sample total{200, 400, 6, 8};
+  constexpr bricks::perf_sample start{100, 100, 2, 4};
+  constexpr auto delta = total - start;
+  static_assert(delta.cycles == 100 && delta.instructions == 300);
+  static_assert(delta.cache_misses == 4 && delta.branch_misses == 4);
+  CHECK(delta.ipc() == doctest::Approx(3.0));
+
+  bricks::perf_sample sum;
+  sum += delta;
+  sum += delta;
+  CHECK(sum.instructions == 600);
+  CHECK(bricks::perf_sample{}.ipc() == 0.0);
+}
+
+TEST_SUITE_END();
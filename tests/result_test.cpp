@@ -1,7 +1,14 @@
 #include <doctest/doctest.h>
 
+#include <array>
+#include <bricks/alloc_tracker.hpp>
 #include <bricks/result.hpp>
+#include <string>
+#include <string_view>
+#include <stdexcept>
+#include <system_error>
 #include <unordered_map>
+#include <vector>
 
 TEST_SUITE_BEGIN("[result]");
 
@@ -369,6 +376,74 @@ TEST_CASE("result from try")
   }
 }
 
+TEST_CASE("result from try with a mapping")
+{
+  enum class parse_error { invalid, out_of_range, other };
+  using parse_errors =
+      exception_mapping<catch_as<std::invalid_argument, parse_error::invalid>,
+                        catch_as<std::out_of_range, parse_error::out_of_range>,
+                        catch_as<std::exception, parse_error::other>>;
+
+  SUBCASE("example")
+  {
+    /// [result-from-try-mapping-example]
+    enum class conversion_error { invalid, out_of_range };
+    using conversion_errors =
+        bricks::exception_mapping<catch_as<std::invalid_argument, conversion_error::invalid>,
+                                  catch_as<std::out_of_range, conversion_error::out_of_range>>;
+
+    auto parse = [](const std::string& str) {
+      return bricks::result_from_try<conversion_errors>([&str] { return std::stoi(str); });
+    };
+
+    CHECK(parse("42").unwrap() == 42);
+    CHECK(parse("forty-two").unwrap_error() == conversion_error::invalid);
+    CHECK(parse("99999999999999999999").unwrap_error() == conversion_error::out_of_range);
+    /// [result-from-try-mapping-example]
+  }
+
+  SUBCASE("the first matching mapping wins")
+  {
+    auto res = result_from_try<parse_errors>([]() -> int { throw std::invalid_argument{"x"}; });
+    CHECK(res.unwrap_error() == parse_error::invalid);
+
+    // A base class listed first catches derived exceptions.
+    using base_first = exception_mapping<catch_as<std::exception, parse_error::other>,
+                                         catch_as<std::invalid_argument, parse_error::invalid>>;
+    auto base = result_from_try<base_first>([]() -> int { throw std::invalid_argument{"x"}; });
+    CHECK(base.unwrap_error() == parse_error::other);
+
+    auto derived = result_from_try<parse_errors>([]() -> int { throw std::length_error{"x"}; });
+    CHECK(derived.unwrap_error() == parse_error::other);
+  }
+
+  SUBCASE("unmapped exceptions propagate")
+  {
+    using narrow = exception_mapping<catch_as<std::invalid_argument, parse_error::invalid>>;
+    CHECK_THROWS_AS((void)result_from_try<narrow>([]() -> int { throw std::out_of_range{"x"}; }),
+                    std::out_of_range);
+  }
+
+  SUBCASE("values and void")
+  {
+    auto value = result_from_try<parse_errors>([] { return std::string{"value"}; });
+    CHECK(value.unwrap() == "value");
+
+    bool called = false;
+    auto none = result_from_try<parse_errors>([&called] { called = true; });
+    CHECK(none.is_value());
+    CHECK(called);
+  }
+
+  SUBCASE("the result is trivially copyable")
+  {
+    const auto res = result_from_try<parse_errors>([] { return 1; });
+    using mapped = std::decay_t<decltype(res)>;
+    CHECK((std::is_same_v<mapped, result<int, parse_error>>));
+    CHECK(std::is_trivially_copyable_v<mapped>);
+  }
+}
+
 TEST_CASE("Assignment")
 {
   SUBCASE("value")
@@ -978,6 +1053,67 @@ TEST_CASE("Expect")
                          "The result is an error.", bricks::bad_result_access);
     /// [result-expect-example]
   }
+
+  SUBCASE("message types")
+  {
+    result<int, std::string> res{"error"};
+    const std::string str = "from string";
+    CHECK_THROWS_WITH_AS([[maybe_unused]] const auto ret = res.expect(str), "from string",
+                         bad_result_access);
+    CHECK_THROWS_WITH_AS([[maybe_unused]] const auto ret = res.expect(std::string_view{"view"}),
+                         "view", bad_result_access);
+  }
+
+  SUBCASE("lazy message")
+  {
+    result<int, std::string> res{42};
+    bool called = false;
+    CHECK_EQ(res.expect([&called] {
+      called = true;
+      return std::string{"never built"};
+    }),
+             42);
+    CHECK_FALSE(called);
+  }
+
+  SUBCASE("lazy example")
+  {
+    /// [result-expect-lazy-example]
+    const int id = 7;
+    bricks::result<int, std::string> res{"not found"};
+    CHECK_THROWS_WITH_AS(
+        [[maybe_unused]] const auto ret =
+            res.expect([&] { return "Lookup of " + std::to_string(id) + " failed."; }),
+        "Lookup of 7 failed.", bricks::bad_result_access);
+    /// [result-expect-lazy-example]
+  }
+
+  SUBCASE("success path does not allocate")
+  {
+    result<int, std::string> res{42};
+    const bricks::allocation_counter counter;
+    CHECK_EQ(res.expect("a message that is too long for the small string optimization"), 42);
+    CHECK_EQ(res.expect(std::string_view{"another message, too long for small strings"}), 42);
+    CHECK_EQ(res.expect([] { return std::string(100, 'x'); }), 42);
+    CHECK_EQ(res.unwrap(), 42);
+    CHECK_EQ(counter.allocations(), 0);
+  }
+
+  SUBCASE("failures are traced")
+  {
+    auto& trace = bricks::expectation_trace::global();
+    trace.clear();
+    result<int, std::string> res{"error"};
+    const auto line = __LINE__ + 1;
+    CHECK_THROWS_AS([[maybe_unused]] const auto ret = res.unwrap(), bad_result_access);
+
+    const auto recent = trace.recent();
+    REQUIRE(recent.size() == 1);
+    CHECK(recent.front().location().line() == line);
+    CHECK(std::string_view{recent.front().location().file_name()}.find("result_test.cpp") !=
+          std::string_view::npos);
+    CHECK(recent.front().message() == "Called `unwrap` on a result that is an error.");
+  }
 }
 
 TEST_CASE("Expect error")
@@ -1004,6 +1140,19 @@ TEST_CASE("Expect error")
         "The result is a value.", bricks::bad_result_access);
     /// [result-expect-error-example]
   }
+
+  SUBCASE("lazy message")
+  {
+    result<int, std::string> res{42};
+    CHECK_THROWS_WITH_AS([[maybe_unused]] const auto ret =
+                             res.expect_error([] { return std::string{"built lazily"}; }),
+                         "built lazily", bad_result_access);
+
+    res = "error";
+    const bricks::allocation_counter counter;
+    CHECK_EQ(res.expect_error([] { return std::string(100, 'x'); }), "error");
+    CHECK_EQ(counter.allocations(), 0);
+  }
 }
 
 TEST_CASE("Unwrap or default")
@@ -1173,6 +1322,80 @@ TEST_CASE("Swap")
   }
 }
 
+namespace {
+
+/// [result-constexpr-example]
+enum class config_error { zero, too_large };
+
+constexpr auto checked_size(int size) -> bricks::result<int, config_error>
+{
+  if (size == 0) return config_error::zero;
+  if (size > 1024) return config_error::too_large;
+  return size;
+}
+
+// Validated at compile time, there is nothing left to do at startup.
+constexpr auto buffer_size = checked_size(256).map([](int size) { return size * 2; }).unwrap_or(0);
+static_assert(buffer_size == 512);
+static_assert(checked_size(0).unwrap_error() == config_error::zero);
+/// [result-constexpr-example]
+
+constexpr auto halve(int i) -> bricks::result<int, config_error>
+{
+  if (i % 2 != 0) return config_error::zero;
+  return i / 2;
+}
+
+constexpr auto assigned() -> bricks::result<int, config_error>
+{
+  bricks::result<int, config_error> res{1};
+  res = config_error::too_large;
+  res = 7;
+  res = bricks::ok<int>{8};
+  return res;
+}
+
+constexpr auto table() -> std::array<int, 4>
+{
+  std::array<int, 4> values{};
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = checked_size(static_cast<int>(i) * 512).unwrap_or(-1);
+  }
+  return values;
+}
+
+}  // namespace
+
+TEST_CASE("Constant evaluation")
+{
+  static_assert(checked_size(8).is_value());
+  static_assert(checked_size(2048).is_error());
+  static_assert(checked_size(8).unwrap() == 8);
+  static_assert(checked_size(8).expect("valid") == 8);
+  static_assert(checked_size(8).and_then(halve).and_then(halve).unwrap() == 2);
+  static_assert(checked_size(6).and_then(halve).and_then(halve).is_error());
+  static_assert(checked_size(0).map_error([](config_error) { return 1; }).unwrap_error() == 1);
+  static_assert(checked_size(0).or_else(
+                    [](config_error) -> bricks::result<int, config_error> { return 3; })
+                    .unwrap() == 3);
+  static_assert(checked_size(0).map_or(5, [](int i) { return i; }) == 5);
+  static_assert(checked_size(0).unwrap_or_default() == 0);
+  static_assert(checked_size(8) == checked_size(8));
+  static_assert(checked_size(8) != checked_size(0));
+  static_assert(assigned().unwrap() == 8);
+  static_assert(table()[1] == 512 && table()[3] == -1);
+
+  constexpr bricks::result<void, config_error> done{bricks::ok<void>{}};
+  static_assert(done.is_value());
+  static_assert(done.map([] { return 1; }).unwrap() == 1);
+
+  static constexpr int referenced = 4;
+  constexpr bricks::result<const int&, config_error> ref{referenced};
+  static_assert(ref.unwrap() == 4);
+
+  CHECK(buffer_size == 512);
+}
+
 TEST_CASE("Hash")
 {
   SUBCASE("example")
@@ -1188,4 +1411,177 @@ TEST_CASE("Hash")
   }
 }
 
+TEST_CASE("Void result")
+{
+  SUBCASE("example")
+  {
+    /// [result-void-example]
+    auto check_positive = [](int i) -> bricks::result<void, std::string> {
+      if (i <= 0) return std::string{"not positive"};
+      return bricks::ok<void>{};
+    };
+
+    CHECK(check_positive(1).is_value());
+    CHECK(check_positive(0).unwrap_error() == "not positive");
+    CHECK(check_positive(1).map([] { return 42; }).unwrap() == 42);
+    /// [result-void-example]
+  }
+
+  SUBCASE("accessors")
+  {
+    result<void, int> res{ok<void>{}};
+    CHECK_NOTHROW(res.unwrap());
+    CHECK_NOTHROW(res.expect("value"));
+    CHECK_THROWS_AS([[maybe_unused]] const auto e = res.unwrap_error(), bad_result_access);
+    CHECK(res == result<void, int>{ok<void>{}});
+
+    res = 3;
+    CHECK(res.is_error());
+    CHECK_THROWS_AS(res.unwrap(), bad_result_access);
+    CHECK(res.unwrap_error() == 3);
+    CHECK(res != result<void, int>{ok<void>{}});
+  }
+
+  SUBCASE("monadic operations")
+  {
+    const result<void, int> success{ok<void>{}};
+    const result<void, int> failure{7};
+
+    int calls = 0;
+    auto count = [&calls] { ++calls; };
+    CHECK(success.map(count).is_value());
+    CHECK(failure.map(count).unwrap_error() == 7);
+    CHECK(calls == 1);
+
+    CHECK(success.map_or(0, [] { return 1; }) == 1);
+    CHECK(failure.map_or(0, [] { return 1; }) == 0);
+    CHECK(failure.map_or_else([](int e) { return e; }, [] { return 1; }) == 7);
+    CHECK(success.and_then([]() -> result<int, int> { return ok<int>{5}; }).unwrap() == 5);
+    CHECK(failure.and_then([]() -> result<int, int> { return ok<int>{5}; }).unwrap_error() == 7);
+    CHECK(failure.map_error([](int e) { return e * 2; }).unwrap_error() == 14);
+    CHECK(success.map_error([](int e) { return e * 2; }).is_value());
+    CHECK(failure.or_else([](int) -> result<void, std::string> { return ok<void>{}; })
+              .is_value());
+    CHECK(result<int, int>{ok<int>{1}}.map([](int) {}).is_value());
+  }
+
+  SUBCASE("from try")
+  {
+    auto res = result<void, int>::from_try_or([] {}, 1);
+    CHECK(res.is_value());
+    res = result<void, int>::from_try_or([] { throw std::runtime_error{"error"}; }, 1);
+    CHECK(res.unwrap_error() == 1);
+
+    auto caught = result_from_try([] { throw std::runtime_error{"error"}; });
+    CHECK(caught.is_error());
+    CHECK(result_from_try([] {}).is_value());
+  }
+
+  SUBCASE("hash")
+  {
+    std::unordered_map<result<void, int>, int> map;
+    map[result<void, int>{ok<void>{}}] = 1;
+    map[result<void, int>{2}] = 2;
+    CHECK(map.size() == 2);
+  }
+}
+
+template <typename R, typename U, typename = void>
+struct can_unwrap_or : std::false_type {
+};
+
+template <typename R, typename U>
+struct can_unwrap_or<R, U,
+                     std::void_t<decltype(std::declval<const R&>().unwrap_or(std::declval<U>()))>>
+    : std::true_type {
+};
+
+template <typename R, typename U>
+constexpr bool can_unwrap_or_v = can_unwrap_or<R, U>::value;
+
+TEST_CASE("Reference result")
+{
+  SUBCASE("example")
+  {
+    /// [result-reference-example]
+    std::unordered_map<std::string, std::string> config{{"name", "bricks"}};
+    auto lookup = [&config](const std::string& key) -> bricks::result<std::string&, std::errc> {
+      auto it = config.find(key);
+      if (it == config.end()) return std::errc::invalid_argument;
+      return it->second;
+    };
+
+    lookup("name").unwrap() = "mortar";
+    CHECK(config["name"] == "mortar");
+    CHECK(lookup("size").unwrap_error() == std::errc::invalid_argument);
+    /// [result-reference-example]
+  }
+
+  SUBCASE("stores a pointer")
+  {
+    CHECK(sizeof(ok<std::string&>) == sizeof(std::string*));
+    std::string text = "text";
+    result<std::string&, int> res{text};
+    CHECK(&res.unwrap() == &text);
+    CHECK(&res.expect("value") == &text);
+  }
+
+  SUBCASE("const reference")
+  {
+    const std::vector<int> values{1, 2, 3};
+    result<const std::vector<int>&, int> res{values};
+    CHECK(&res.unwrap() == &values);
+    CHECK(res.map([](const std::vector<int>& v) { return v.size(); }).unwrap() == 3);
+  }
+
+  SUBCASE("map to a reference")
+  {
+    std::vector<int> values{1, 2, 3};
+    result<std::vector<int>&, int> res{values};
+    auto first = res.map([](std::vector<int>& v) -> int& { return v.front(); });
+    first.unwrap() = 10;
+    CHECK(values.front() == 10);
+    CHECK(res.and_then([](std::vector<int>& v) -> result<int&, int> { return ok<int&>{v.back()}; })
+              .unwrap() == 3);
+  }
+
+  SUBCASE("comparison compares the referenced values")
+  {
+    int a = 1;
+    int b = 1;
+    int c = 2;
+    CHECK(result<int&, std::string>{a} == result<int&, std::string>{b});
+    CHECK(result<int&, std::string>{a} != result<int&, std::string>{c});
+    CHECK(std::hash<result<int&, std::string>>{}(result<int&, std::string>{a}) ==
+          std::hash<result<int&, std::string>>{}(result<int&, std::string>{b}));
+  }
+
+  SUBCASE("does not bind to temporaries")
+  {
+    static_assert(std::is_constructible_v<result<const int&, std::string>, const int&>);
+    static_assert(!std::is_constructible_v<result<const int&, std::string>, int&&>);
+    static_assert(!std::is_constructible_v<result<const std::string&, int>, std::string>);
+    static_assert(!std::is_constructible_v<result<const std::string&, int>, const char*>);
+    static_assert(!std::is_constructible_v<ok<const int&>, int&&>);
+    static_assert(!std::is_assignable_v<ok<const int&>&, int&&>);
+    static_assert(can_unwrap_or_v<result<const int&, std::string>, const int&>);
+    static_assert(!can_unwrap_or_v<result<const int&, std::string>, int&&>);
+    static_assert(can_unwrap_or_v<result<int, std::string>, int&&>);
+  }
+
+  SUBCASE("assignment rebinds")
+  {
+    int a = 1;
+    int b = 2;
+    result<int&, std::string> res{a};
+    res = ok<int&>{b};
+    res.unwrap() = 3;
+    CHECK(a == 1);
+    CHECK(b == 3);
+
+    res = "error";
+    CHECK(res.unwrap_error() == "error");
+  }
+}
+
 TEST_SUITE_END();
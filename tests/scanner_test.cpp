@@ -0,0 +1,101 @@
+#include <doctest/doctest.h>
+
+#include <bricks/scanner.hpp>
+#include <vector>
+
+TEST_SUITE_BEGIN("[scanner]");
+
+TEST_CASE("scanner example")
+{
+  /// [scanner-example]
+  bricks::scanner scan{"x=12 y=-3.5"};
+
+  REQUIRE(scan.consume("x="));
+  CHECK(scan.read<int>().unwrap_or(0) == 12);
+  scan.skip_whitespace();
+  REQUIRE(scan.consume("y="));
+  CHECK(scan.read<double>().unwrap_or(0.0) == -3.5);
+  CHECK(scan.at_end());
+  /// [scanner-example]
+}
+
+TEST_CASE("scanner read field example")
+{
+  /// [scanner-read-field-example]
+  bricks::scanner scan{"123,456,789"};
+
+  std::vector<int> values;
+  while (!scan.at_end()) {
+    auto value = scan.read_field<int>(',');
+    REQUIRE(value.is_value());
+    values.push_back(value.unwrap_or(0));
+  }
+  CHECK(values == std::vector<int>{123, 456, 789});
+  /// [scanner-read-field-example]
+}
+
+TEST_CASE("A failed read does not move the cursor")
+{
+  bricks::scanner scan{"12a"};
+
+  auto text = scan.read<int>();
+  REQUIRE(text.is_value());
+  CHECK(scan.position() == 2);
+
+  text = scan.read<int>();
+  REQUIRE(text.is_error());
+  CHECK(text.unwrap_error() == std::errc::invalid_argument);
+  CHECK(scan.position() == 2);
+  CHECK(scan.remaining() == "a");
+}
+
+TEST_CASE("read_field requires the delimiter")
+{
+  bricks::scanner scan{"1;2"};
+
+  auto value = scan.read_field<int>(',');
+  REQUIRE(value.is_error());
+  CHECK(value.unwrap_error() == std::errc::invalid_argument);
+  CHECK(scan.position() == 0);
+
+  CHECK(scan.read_field<int>(';').unwrap_or(0) == 1);
+  CHECK(scan.read_field<int>(';').unwrap_or(0) == 2);
+  CHECK(scan.at_end());
+}
+
+TEST_CASE("read_field reports out of range values")
+{
+  bricks::scanner scan{"300,1"};
+
+  auto value = scan.read_field<unsigned char>(',');
+  REQUIRE(value.is_error());
+  CHECK(value.unwrap_error() == std::errc::result_out_of_range);
+}
+
+TEST_CASE("read_until returns tokens without copying")
+{
+  const std::string_view input = "name,42,rest";
+  bricks::scanner scan{input};
+
+  const auto name = scan.read_until(',');
+  CHECK(name == "name");
+  CHECK(name.data() == input.data());
+  CHECK(scan.read_field<int>(',').unwrap_or(0) == 42);
+  CHECK(scan.read_until(',') == "rest");
+  CHECK(scan.at_end());
+  CHECK(scan.read_until(',').empty());
+}
+
+TEST_CASE("consume only matches at the cursor")
+{
+  bricks::scanner scan{"ab"};
+
+  CHECK_FALSE(scan.consume('b'));
+  CHECK_FALSE(scan.consume("abc"));
+  CHECK(scan.consume('a'));
+  CHECK(scan.consume("b"));
+  CHECK_FALSE(scan.consume('b'));
+  CHECK(scan.at_end());
+}
+
+TEST_SUITE_END();
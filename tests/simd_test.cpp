@@ -0,0 +1,135 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <bricks/simd.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+
+TEST_SUITE_BEGIN("[simd]");
+
+namespace {
+
+// The same checks for every backend, a kernel written once.
+template <typename Vector>
+void check_backend()
+{
+  using T = typename Vector::value_type;
+  constexpr auto n = Vector::size();
+
+  std::array<T, n> values{};
+  std::iota(values.begin(), values.end(), T{1});
+  const auto vector = Vector::load(values.data());
+  CHECK(bricks::to_array(vector) == values);
+
+  const auto matches = (vector == Vector::broadcast(T{2})).to_bitmask();
+  CHECK(matches == 0b10);
+  CHECK(bricks::first_lane(matches) == 1);
+  CHECK((vector == Vector::broadcast(T{0})).to_bitmask() == 0);
+  const auto all_lanes = n == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1;
+  CHECK((vector == vector).to_bitmask() == all_lanes);
+
+  const auto odd = Vector::broadcast(T{1});
+  CHECK(reduce_max(vector & odd) == T{1});
+  CHECK(reduce_min(vector | odd) == T{1});
+  CHECK(reduce_add(vector) == static_cast<T>(n * (n + 1) / 2));
+  CHECK(reduce_min(vector) == T{1});
+  CHECK(reduce_max(vector) == static_cast<T>(n));
+
+  std::array<T, n> stored{};
+  Vector::broadcast(static_cast<T>(-1)).store(stored.data());
+  CHECK(stored[n - 1] == static_cast<T>(-1));
+}
+
+#ifdef BRICKS_CPU_X86
+__attribute__((target("avx2"), flatten)) void check_avx2()
+{
+  check_backend<bricks::simd<std::int8_t, 32, bricks::simd_abi::avx2>>();
+  check_backend<bricks::simd<std::int16_t, 16, bricks::simd_abi::avx2>>();
+  check_backend<bricks::simd<std::int32_t, 8, bricks::simd_abi::avx2>>();
+  check_backend<bricks::simd<std::int64_t, 4, bricks::simd_abi::avx2>>();
+}
+#endif
+
+}  // namespace
+
+TEST_CASE("simd example")
+{
+  /// [simd-example]
+  const std::array<std::uint8_t, 16> text = {'a', ',', 'b', ',', 'c'};
+  const auto bytes = bricks::simd<std::uint8_t, 16>::load(text.data());
+  const auto commas = (bytes == bricks::simd<std::uint8_t, 16>::broadcast(',')).to_bitmask();
+  CHECK(commas == 0b1010);  // The second and fourth byte
+  CHECK(bricks::first_lane(commas) == 1);
+  /// [simd-example]
+}
+
+TEST_CASE("scalar backend")
+{
+  check_backend<bricks::simd<std::int8_t, 16, bricks::simd_abi::scalar>>();
+  check_backend<bricks::simd<std::uint16_t, 8, bricks::simd_abi::scalar>>();
+  check_backend<bricks::simd<std::int32_t, 3, bricks::simd_abi::scalar>>();
+  check_backend<bricks::simd<std::int64_t, 64, bricks::simd_abi::scalar>>();
+}
+
+TEST_CASE("default 16 byte backend")
+{
+  check_backend<bricks::simd<std::int8_t, 16>>();
+  check_backend<bricks::simd<std::uint16_t, 8>>();
+  check_backend<bricks::simd<std::int32_t, 4>>();
+  check_backend<bricks::simd<std::uint64_t, 2>>();
+}
+
+TEST_CASE("32 bytes only default to AVX2 when compiling for it")
+{
+  using abi = bricks::simd<std::uint8_t, 32>::abi_type;
+#ifdef __AVX2__
+  CHECK(std::is_same_v<abi, bricks::simd_abi::avx2>);
+#else
+  CHECK(std::is_same_v<abi, bricks::simd_abi::scalar>);
+#endif
+  check_backend<bricks::simd<std::int8_t, 32>>();
+}
+
+TEST_CASE("64 bit lanes compare both halves")
+{
+  const std::array<std::uint64_t, 2> values = {1, std::uint64_t{1} << 32U};
+  using vector = bricks::simd<std::uint64_t, 2>;
+  CHECK((vector::load(values.data()) == vector::broadcast(1)).to_bitmask() == 0b01);
+}
+
+#ifdef BRICKS_CPU_X86
+TEST_CASE("avx2 backend")
+{
+  if (!bricks::cpu_features::current().avx2) return;
+  check_avx2();
+}
+#endif
+
+TEST_CASE("shuffle picks bytes within groups of 16")
+{
+  using bytes = bricks::simd<std::uint8_t, 16>;
+  std::array<std::uint8_t, 16> values{};
+  std::iota(values.begin(), values.end(), std::uint8_t{10});
+  std::array<std::uint8_t, 16> indices{};
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<std::uint8_t>(15 - i);
+  }
+  indices[0] = 0x80;
+
+  const auto scalar = bricks::simd<std::uint8_t, 16, bricks::simd_abi::scalar>::load(values.data())
+                          .shuffle(bricks::simd<std::uint8_t, 16, bricks::simd_abi::scalar>::load(
+                              indices.data()));
+  const auto expected = bricks::to_array(scalar);
+  CHECK(expected[0] == 0);
+  CHECK(expected[1] == 24);
+  CHECK(expected[15] == 10);
+
+  if (bricks::cpu_features::current().ssse3) {
+    CHECK(bricks::to_array(bytes::load(values.data()).shuffle(bytes::load(indices.data()))) ==
+          expected);
+  }
+}
+
+TEST_SUITE_END();
@@ -0,0 +1,215 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <bricks/alloc_tracker.hpp>
+#include <bricks/small_vector.hpp>
+#include <list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+TEST_SUITE_BEGIN("[small_vector]");
+
+namespace {
+
+// Owns a heap int and counts its moves, so relocation by memcpy is observable.
+struct counted_box {
+  static inline int moves = 0;
+
+  explicit counted_box(int value) : ptr(new int{value}) {}
+  counted_box(const counted_box& other) : ptr(new int{*other.ptr}) {}
+  counted_box(counted_box&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)) { ++moves; }
+  auto operator=(const counted_box&) -> counted_box& = delete;
+  auto operator=(counted_box&&) -> counted_box& = delete;
+  ~counted_box() { delete ptr; }
+
+  int* ptr;
+};
+
+struct relocatable_box : counted_box {
+  using counted_box::counted_box;
+};
+
+// Has a throwing move constructor, so it is copied when relocated, and throws on a chosen copy.
+struct throwing_copy {
+  static inline int copies_until_throw = -1;
+
+  explicit throwing_copy(int value) : ptr(new int{value}) {}
+  throwing_copy(const throwing_copy& other)
+  {
+    if (copies_until_throw >= 0 && copies_until_throw-- == 0) throw std::runtime_error{"copy"};
+    ptr = new int{*other.ptr};
+  }
+  throwing_copy(throwing_copy&& other) noexcept(false) : ptr(std::exchange(other.ptr, nullptr)) {}
+  auto operator=(const throwing_copy&) -> throwing_copy& = delete;
+  auto operator=(throwing_copy&&) -> throwing_copy& = delete;
+  ~throwing_copy() { delete ptr; }
+
+  int* ptr{nullptr};
+};
+
+}  // namespace
+
+template <>
+struct bricks::is_trivially_relocatable<relocatable_box> : std::true_type {
+};
+
+TEST_CASE("small_vector example")
+{
+  /// [small_vector-example]
+  const bricks::allocation_counter counter;
+
+  bricks::small_vector<int, 4> numbers{1, 2, 3};
+  numbers.push_back(4);
+  CHECK(numbers.is_inline());
+  CHECK(counter.allocations() == 0);  // Up to four elements are stored inline
+
+  numbers.push_back(5);
+  CHECK_FALSE(numbers.is_inline());
+  CHECK(counter.allocations() == 1);  // The fifth moves them to the heap
+  /// [small_vector-example]
+}
+
+TEST_CASE("grows and keeps the elements")
+{
+  bricks::small_vector<std::string, 2> strings;
+  for (int i = 0; i < 100; ++i) {
+    strings.push_back(std::to_string(i) + " is a string too long for the small string buffer");
+  }
+  REQUIRE(strings.size() == 100);
+  CHECK(strings.capacity() >= 100);
+  for (int i = 0; i < 100; ++i) {
+    CHECK(strings[static_cast<std::size_t>(i)].rfind(std::to_string(i) + " ", 0) == 0);
+  }
+  CHECK(strings.front().rfind("0 ", 0) == 0);
+  CHECK(strings.back().rfind("99 ", 0) == 0);
+}
+
+TEST_CASE("push_back of an own element while growing")
+{
+  bricks::small_vector<std::string, 2> strings{"first element, longer than the small buffer", "b"};
+  strings.push_back(strings[0]);
+  REQUIRE(strings.size() == 3);
+  CHECK(strings[2] == strings[0]);
+}
+
+TEST_CASE("copy and move")
+{
+  SUBCASE("inline")
+  {
+    bricks::small_vector<std::string, 4> original{"a", "b"};
+    auto copy = original;
+    CHECK(copy == original);
+
+    auto moved = std::move(original);
+    CHECK(moved == copy);
+    CHECK(moved.is_inline());
+    CHECK(original.empty());  // NOLINT(bugprone-use-after-move)
+  }
+
+  SUBCASE("heap")
+  {
+    bricks::small_vector<int, 2> original{1, 2, 3};
+    const auto* data = original.data();
+    auto moved = std::move(original);
+    CHECK(moved.data() == data);  // The heap buffer is taken over
+    CHECK(original.empty());      // NOLINT(bugprone-use-after-move)
+    CHECK(original.is_inline());  // NOLINT(bugprone-use-after-move)
+
+    bricks::small_vector<int, 2> assigned{4};
+    assigned = moved;
+    CHECK(assigned == bricks::small_vector<int, 2>{1, 2, 3});
+    assigned = bricks::small_vector<int, 2>{5};
+    CHECK(assigned == bricks::small_vector<int, 2>{5});
+    CHECK(assigned.is_inline());
+  }
+}
+
+TEST_CASE("construct from iterators")
+{
+  SUBCASE("pointers to trivially copyable elements")
+  {
+    const std::array<int, 6> numbers{1, 2, 3, 4, 5, 6};
+    const bricks::allocation_counter counter;
+    const bricks::small_vector<int, 2> copy(numbers.data(), numbers.data() + numbers.size());
+    CHECK(counter.allocations() == 1);  // Reserved once, then copied with memcpy
+    CHECK(copy == bricks::small_vector<int, 2>{1, 2, 3, 4, 5, 6});
+
+    const auto copy_of_copy = copy;
+    CHECK(copy_of_copy == copy);
+  }
+
+  SUBCASE("forward iterators")
+  {
+    const std::list<std::string> words{"a", "b", "c"};
+    const bricks::small_vector<std::string, 2> copy(words.begin(), words.end());
+    CHECK(copy == bricks::small_vector<std::string, 2>{"a", "b", "c"});
+  }
+
+  SUBCASE("empty")
+  {
+    const std::array<int, 0> none{};
+    const bricks::small_vector<int, 2> copy(none.data(), none.data());
+    CHECK(copy.empty());
+  }
+}
+
+TEST_CASE("resize, pop_back and clear")
+{
+  bricks::small_vector<int, 2> numbers;
+  numbers.resize(5);
+  CHECK(numbers == bricks::small_vector<int, 2>{0, 0, 0, 0, 0});
+  numbers.pop_back();
+  CHECK(numbers.size() == 4);
+  numbers.resize(1);
+  CHECK(numbers == bricks::small_vector<int, 2>{0});
+  numbers.clear();
+  CHECK(numbers.empty());
+  CHECK_THROWS_AS((void)numbers.at(0), std::out_of_range);
+}
+
+TEST_CASE("trivially relocatable elements are moved with memcpy")
+{
+  SUBCASE("relocatable")
+  {
+    bricks::small_vector<relocatable_box, 1> boxes;
+    boxes.emplace_back(1);
+    counted_box::moves = 0;
+    boxes.emplace_back(2);
+    boxes.emplace_back(3);
+    auto moved = std::move(boxes);
+    CHECK(counted_box::moves == 0);
+    CHECK(*moved[0].ptr == 1);
+    CHECK(*moved[2].ptr == 3);
+  }
+
+  SUBCASE("not relocatable")
+  {
+    bricks::small_vector<counted_box, 1> boxes;
+    boxes.emplace_back(1);
+    counted_box::moves = 0;
+    boxes.emplace_back(2);
+    CHECK(counted_box::moves == 1);
+    CHECK(*boxes[0].ptr == 1);
+    CHECK(*boxes[1].ptr == 2);
+  }
+}
+
+TEST_CASE("a throwing relocation while growing leaves the vector unchanged")
+{
+  bricks::small_vector<throwing_copy, 2> values;
+  values.emplace_back(1);
+  values.emplace_back(2);
+
+  throwing_copy::copies_until_throw = 1;  // The second element throws when copied
+  CHECK_THROWS_AS(values.emplace_back(3), std::runtime_error);
+  throwing_copy::copies_until_throw = -1;
+
+  CHECK(values.is_inline());
+  REQUIRE(values.size() == 2);
+  CHECK(*values[0].ptr == 1);
+  CHECK(*values[1].ptr == 2);
+}
+
+TEST_SUITE_END();
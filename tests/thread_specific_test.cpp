@@ -0,0 +1,131 @@
+#include <doctest/doctest.h>
+
+#include <bricks/ranges.hpp>
+#include <bricks/thread_specific.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("[thread_specific]");
+
+TEST_CASE("thread_specific example")
+{
+  /// [thread_specific-example]
+  bricks::thread_specific<std::uint64_t> partial_sums;
+
+  std::vector<std::thread> workers;
+  for (std::uint64_t worker = 0; worker < 4; ++worker) {
+    workers.emplace_back([&partial_sums, worker] {
+      auto& sum = partial_sums.local();  // No locking after the first call
+      for (std::uint64_t i = 0; i < 1000; ++i) {
+        sum += worker * 1000 + i;
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  const auto total = partial_sums.combine([](auto lhs, auto rhs) { return lhs + rhs; });
+  CHECK(total == 3999 * 4000 / 2);
+  /// [thread_specific-example]
+  CHECK(partial_sums.size() == 4);
+}
+
+TEST_CASE("local returns the same instance on a thread")
+{
+  bricks::thread_specific<int> counter;
+  CHECK(counter.empty());
+  ++counter.local();
+  ++counter.local();
+  CHECK(counter.local() == 2);
+  CHECK(counter.size() == 1);
+
+  int* other = nullptr;
+  std::thread{[&] { other = &counter.local(); }}.join();
+  CHECK(other != &counter.local());
+  CHECK(*other == 0);
+  CHECK(counter.size() == 2);
+}
+
+TEST_CASE("instances are constructed with the factory and isolated on cache lines")
+{
+  bricks::thread_specific<std::string> names{[] { return std::string{"thread"}; }};
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 3; ++i) {
+    threads.emplace_back([&names, i] { names.local() += std::to_string(i); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::set<std::string> seen{names.begin(), names.end()};
+  CHECK(seen == std::set<std::string>{"thread0", "thread1", "thread2"});
+
+  std::set<std::uintptr_t> lines;
+  for (const auto& name : names) {
+    lines.insert(reinterpret_cast<std::uintptr_t>(&name) / 64);  // NOLINT
+  }
+  CHECK(lines.size() == 3);
+}
+
+TEST_CASE("enumerate over the instances")
+{
+  bricks::thread_specific<int> values{[] { return 7; }};
+  (void)values.local();
+  std::thread{[&values] { values.local() = 8; }}.join();
+
+  std::size_t count = 0;
+  int sum = 0;
+  for (auto [index, value] : bricks::enumerate(values)) {
+    CHECK(index == count);
+    sum += value;
+    ++count;
+  }
+  CHECK(count == 2);
+  CHECK(sum == 15);
+}
+
+TEST_CASE("clear gives threads new instances")
+{
+  bricks::thread_specific<int> values;
+  values.local() = 5;
+  CHECK(values.combine(1, [](int lhs, int rhs) { return lhs * rhs; }) == 5);
+
+  values.clear();
+  CHECK(values.empty());
+  CHECK(values.combine(1, [](int lhs, int rhs) { return lhs * rhs; }) == 1);
+  CHECK(values.local() == 0);
+  CHECK(values.size() == 1);
+}
+
+TEST_CASE("The slots of a thread stay bounded")
+{
+  const auto& entries = bricks::detail::thread_specific_slots::local().entries;
+
+  SUBCASE("when clearing repeatedly")
+  {
+    bricks::thread_specific<int> values;
+    values.local() = 1;
+    const auto before = entries.size();
+    for (int i = 0; i < 1000; ++i) {
+      values.clear();
+      values.local() = i;
+    }
+    CHECK(entries.size() == before);
+  }
+
+  SUBCASE("when creating many short lived instances")
+  {
+    for (int i = 0; i < 1000; ++i) {
+      bricks::thread_specific<int> values;
+      values.local() = i;
+    }
+    CHECK(entries.size() < 64);
+  }
+}
+
+TEST_SUITE_END();
@@ -1,11 +1,22 @@
 #include <doctest/doctest.h>
 
 #include <bricks/timer.hpp>
+#include <bricks/virtual_clock.hpp>
+#include <chrono>
+#include <future>
 
 #include "string_makers.hpp"
 
 TEST_SUITE_BEGIN("[timer]");
 
+using namespace std::chrono_literals;  // NOLINT
+
+namespace {
+
+// The real timers are tested with short timeouts, or with long ones that get aborted. The same
+// cases also run on a virtual clock, which never sleeps and checks the exact order of expiry.
+using virtual_timer = bricks::basic_timer<bricks::virtual_clock>;
+
 constexpr uint8_t k_instant_timeout_wait_time_ms = 1;
 constexpr uint8_t k_wait_time_ms = 5;
 
@@ -15,6 +26,16 @@ void check_token_result(bricks::timer::completion_token& token, uint8_t wait_tim
   REQUIRE(token.wait_for(std::chrono::milliseconds(wait_time_ms)) == std::future_status::ready);
   CHECK_NOTHROW(token.get());
 }
+
+void check_completed(virtual_timer::completion_token& token) { check_token_result(token, 0); }
+
+auto is_ready(const std::future<void>& token) -> bool
+{
+  return token.wait_for(0s) == std::future_status::ready;
+}
+
+}  // namespace
+
 TEST_CASE("example")
 {
   /// [timer-example]
@@ -107,9 +128,13 @@ TEST_CASE("Can be aborted and restarted")
 
 TEST_CASE("Can be destroyed while a timer is running")
 {
-  bricks::timer t;
-  auto completion_future = t.start(std::chrono::milliseconds(100));
-  CHECK(completion_future.valid());
+  bricks::timer::completion_token completion_future;
+  {
+    bricks::timer t;
+    completion_future = t.start(std::chrono::milliseconds(100));
+    CHECK(completion_future.valid());
+  }
+  check_token_result(completion_future, k_instant_timeout_wait_time_ms);
 }
 
 TEST_CASE("Calling abort twice does not cause a crash")
@@ -126,4 +151,125 @@ TEST_CASE("Negative durations are treated as 0")
   check_token_result(completion_future, k_instant_timeout_wait_time_ms);
 }
 
+TEST_CASE("Can use another clock")
+{
+  bricks::basic_timer<std::chrono::system_clock> t;
+  auto completion_future = t.start(std::chrono::milliseconds(1));
+  check_token_result(completion_future, k_wait_time_ms);
+}
+
+TEST_CASE("Can be default constructed on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  auto completion_future = t.start();
+  check_completed(completion_future);
+}
+
+TEST_CASE("Can be started with a duration on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  auto completion_future = t.start(1ms);
+  CHECK_FALSE(is_ready(completion_future));
+  clock.advance(1ms);
+  check_completed(completion_future);
+}
+
+TEST_CASE("Can be aborted on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  auto completion_future = t.start(100ms);
+  CHECK(completion_future.valid());
+  t.abort();
+  check_completed(completion_future);
+  CHECK(clock.pending() == 0);
+}
+
+TEST_CASE("Can start multiple timers on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  auto completion_future_1 = t.start(2ms);
+  auto completion_future_2 = t.start(1ms);
+  clock.advance(1ms);
+  CHECK_FALSE(is_ready(completion_future_1));
+  check_completed(completion_future_2);
+  clock.advance(1ms);
+  check_completed(completion_future_1);
+}
+
+TEST_CASE("Can abort multiple timers on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  auto completion_future_1 = t.start(100ms);
+  auto completion_future_2 = t.start(100ms);
+  CHECK(completion_future_1.valid());
+  CHECK(completion_future_2.valid());
+  t.abort();
+  check_completed(completion_future_1);
+  check_completed(completion_future_2);
+}
+
+TEST_CASE("Can start a timer after another finished on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  auto completion_future = t.start(1ms);
+  CHECK(completion_future.valid());
+  clock.advance(1ms);
+  check_completed(completion_future);
+
+  completion_future = t.start(1ms);
+  CHECK_FALSE(is_ready(completion_future));
+  clock.advance(1ms);
+  check_completed(completion_future);
+}
+
+TEST_CASE("Can be aborted and restarted on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  auto completion_future = t.start(100ms);
+  CHECK(completion_future.valid());
+  t.abort();
+  check_completed(completion_future);
+
+  completion_future = t.start(1ms);
+  CHECK_FALSE(is_ready(completion_future));
+  clock.advance(1ms);
+  check_completed(completion_future);
+}
+
+TEST_CASE("Can be destroyed while a timer is running on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer::completion_token completion_future;
+  {
+    virtual_timer t{clock};
+    completion_future = t.start(100ms);
+    CHECK(completion_future.valid());
+  }
+  check_completed(completion_future);
+}
+
+TEST_CASE("Calling abort twice does not cause a crash on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  CHECK_NOTHROW(t.abort());
+  CHECK_NOTHROW(t.abort());
+}
+
+TEST_CASE("Negative durations are treated as 0 on a virtual clock")
+{
+  bricks::virtual_clock clock;
+  virtual_timer t{clock};
+  auto completion_future = t.start(-1ms);
+  check_completed(completion_future);
+  CHECK(clock.pending() == 0);
+}
+
 TEST_SUITE_END();
@@ -0,0 +1,221 @@
+#include <doctest/doctest.h>
+
+#include <array>
+#include <bricks/charconv.hpp>
+#include <bricks/timestamp.hpp>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+template <typename Duration = std::chrono::nanoseconds>
+auto at(std::int64_t seconds, Duration fraction = Duration::zero()) -> bricks::sys_time<Duration>
+{
+  return bricks::sys_time<Duration>{std::chrono::seconds{seconds} + fraction};
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("[timestamp]");
+
+TEST_CASE("parse_timestamp example")
+{
+  /// [parse_timestamp-example]
+  auto time = bricks::parse_timestamp("2023-11-14T22:13:20.5Z");
+  REQUIRE(time.is_value());
+  CHECK(time.unwrap().time_since_epoch() == 1700000000s + 500ms);
+
+  auto shifted = bricks::parse_timestamp<std::chrono::seconds>("2023-11-15T00:13:20+02:00");
+  REQUIRE(shifted.is_value());
+  CHECK(shifted.unwrap().time_since_epoch() == 1700000000s);
+  /// [parse_timestamp-example]
+}
+
+TEST_CASE("parse_epoch_timestamp example")
+{
+  /// [parse_epoch_timestamp-example]
+  auto time = bricks::parse_epoch_timestamp<std::chrono::microseconds>("1700000000.123456");
+  REQUIRE(time.is_value());
+  CHECK(time.unwrap().time_since_epoch() == 1700000000s + 123456us);
+  /// [parse_epoch_timestamp-example]
+}
+
+TEST_CASE("format_timestamp example")
+{
+  /// [format_timestamp-example]
+  const bricks::sys_time<std::chrono::milliseconds> time{1700000000s + 42ms};
+  CHECK(bricks::format_timestamp(time).unwrap_or("") == "2023-11-14T22:13:20.042Z");
+  /// [format_timestamp-example]
+}
+
+TEST_CASE("timestamp_parser example")
+{
+  /// [timestamp_parser-example]
+  bricks::timestamp_parser parser;
+  auto first = parser.parse("2023-11-14T22:13:20Z");
+  auto second = parser.parse("2023-11-14T22:13:21Z");  // Reuses the date.
+  REQUIRE(first.is_value());
+  REQUIRE(second.is_value());
+  CHECK(second.unwrap() - first.unwrap() == 1s);
+  /// [timestamp_parser-example]
+}
+
+TEST_CASE("timestamp_formatter example")
+{
+  /// [timestamp_formatter-example]
+  bricks::timestamp_formatter formatter;
+  CHECK(formatter.format(at(1700000000)).unwrap_or("") == "2023-11-14T22:13:20.000000000Z");
+  CHECK(formatter.format(at<std::chrono::seconds>(1700000001)).unwrap_or("") ==
+        "2023-11-14T22:13:21Z");
+  /// [timestamp_formatter-example]
+}
+
+TEST_CASE("Parses the supported formats")
+{
+  const auto expected = at(1700000000, 120ms);
+  for (const auto* text :
+       {"2023-11-14T22:13:20.12Z", "2023-11-14t22:13:20.120z", "2023-11-14 22:13:20.120000",
+        "2023-11-14T22:13:20,12Z", "2023-11-14T23:13:20.12+01:00", "2023-11-14T23:43:20.12+0130",
+        "2023-11-14T20:13:20.12-02", "2023-11-14T22:13:20.1200000009999Z"}) {
+    CAPTURE(text);
+    auto time = bricks::parse_timestamp(text);
+    REQUIRE(time.is_value());
+    CHECK(time.unwrap() == expected);
+  }
+}
+
+TEST_CASE("Parses dates across the calendar")
+{
+  CHECK(bricks::parse_timestamp("1970-01-01T00:00:00Z").unwrap_or({}) == at(0));
+  CHECK(bricks::parse_timestamp("1969-12-31T23:59:59Z").unwrap_or({}) == at(-1));
+  CHECK(bricks::parse_timestamp("2000-02-29T00:00:00Z").unwrap_or({}) == at(951782400));
+  CHECK(bricks::parse_timestamp<std::chrono::seconds>("0001-01-01T00:00:00Z").unwrap_or({}) ==
+        at<std::chrono::seconds>(-62135596800));
+  CHECK(bricks::parse_timestamp<std::chrono::seconds>("9999-12-31T23:59:59Z").unwrap_or({}) ==
+        at<std::chrono::seconds>(253402300799));
+}
+
+TEST_CASE("Rejects invalid timestamps")
+{
+  const char* text = "";
+  SUBCASE("too short") { text = "2023-11-14T22:13"; }
+  SUBCASE("bad separator") { text = "2023-11-14X22:13:20Z"; }
+  SUBCASE("bad date separator") { text = "2023/11/14T22:13:20Z"; }
+  SUBCASE("letter in year") { text = "20a3-11-14T22:13:20Z"; }
+  SUBCASE("letter in day") { text = "2023-11-1xT22:13:20Z"; }
+  SUBCASE("month 13") { text = "2023-13-14T22:13:20Z"; }
+  SUBCASE("day 0") { text = "2023-11-00T22:13:20Z"; }
+  SUBCASE("no leap day") { text = "2023-02-29T22:13:20Z"; }
+  SUBCASE("no leap day in 1900") { text = "1900-02-29T22:13:20Z"; }
+  SUBCASE("hour 24") { text = "2023-11-14T24:13:20Z"; }
+  SUBCASE("minute 60") { text = "2023-11-14T22:60:20Z"; }
+  SUBCASE("bad time separator") { text = "2023-11-14T22-13-20Z"; }
+  SUBCASE("empty fraction") { text = "2023-11-14T22:13:20.Z"; }
+  SUBCASE("bad offset") { text = "2023-11-14T22:13:20+1"; }
+  SUBCASE("offset minutes") { text = "2023-11-14T22:13:20+01:60"; }
+  SUBCASE("trailing characters") { text = "2023-11-14T22:13:20Zx"; }
+
+  auto time = bricks::parse_timestamp(text);
+  REQUIRE(time.is_error());
+  CHECK(time.unwrap_error() == std::errc::invalid_argument);
+}
+
+TEST_CASE("Reports timestamps the duration cannot represent")
+{
+  auto time = bricks::parse_timestamp<std::chrono::nanoseconds>("2300-01-01T00:00:00Z");
+  REQUIRE(time.is_error());
+  CHECK(time.unwrap_error() == std::errc::result_out_of_range);
+
+  CHECK(bricks::parse_timestamp<std::chrono::microseconds>("2300-01-01T00:00:00Z").is_value());
+}
+
+TEST_CASE("Parses into durations coarser than seconds")
+{
+  auto minutes = bricks::parse_timestamp<std::chrono::minutes>("2023-11-14T22:13:20.5Z");
+  REQUIRE(minutes.is_value());
+  CHECK(minutes.unwrap().time_since_epoch() == std::chrono::minutes{28333333});
+
+  auto before_epoch = bricks::parse_timestamp<std::chrono::hours>("1969-12-31T23:59:59Z");
+  REQUIRE(before_epoch.is_value());
+  CHECK(before_epoch.unwrap().time_since_epoch() == -1h);
+
+  bricks::timestamp_parser parser;
+  CHECK(parser.parse<std::chrono::minutes>("1970-01-01T00:01:59Z").unwrap_or({}) ==
+        bricks::sys_time<std::chrono::minutes>{1min});
+  CHECK(bricks::from_string<bricks::sys_time<std::chrono::hours>>("1970-01-01T02:30:00Z")
+            .unwrap_or({}) == bricks::sys_time<std::chrono::hours>{2h});
+}
+
+TEST_CASE("Both parsers floor times before the epoch")
+{
+  auto epoch = bricks::parse_epoch_timestamp<std::chrono::milliseconds>("-0.0015");
+  REQUIRE(epoch.is_value());
+  CHECK(epoch.unwrap().time_since_epoch() == -2ms);
+
+  auto iso = bricks::parse_timestamp<std::chrono::milliseconds>("1969-12-31T23:59:59.9985Z");
+  REQUIRE(iso.is_value());
+  CHECK(iso.unwrap().time_since_epoch() == -2ms);
+
+  CHECK(bricks::parse_epoch_timestamp<std::chrono::seconds>("-0.5").unwrap_or({}) ==
+        bricks::sys_time<std::chrono::seconds>{-1s});
+}
+
+TEST_CASE("Formats with the precision of the duration")
+{
+  CHECK(bricks::format_timestamp(at<std::chrono::seconds>(0)).unwrap_or("") ==
+        "1970-01-01T00:00:00Z");
+  CHECK(bricks::format_timestamp(at<std::chrono::microseconds>(0, 5us)).unwrap_or("") ==
+        "1970-01-01T00:00:00.000005Z");
+  CHECK(bricks::format_timestamp(at<std::chrono::milliseconds>(-1, 1ms)).unwrap_or("") ==
+        "1969-12-31T23:59:59.001Z");
+  CHECK(bricks::format_timestamp(
+            bricks::sys_time<std::chrono::minutes>{std::chrono::minutes{1}})
+            .unwrap_or("") == "1970-01-01T00:01:00Z");
+
+  const bricks::sys_time<std::chrono::milliseconds> before_epoch{-1ms};
+  CHECK(bricks::format_timestamp(before_epoch).unwrap_or("") == "1969-12-31T23:59:59.999Z");
+}
+
+TEST_CASE("Formatting checks the buffer and the year")
+{
+  std::array<char, 20> buffer{};
+  auto end = bricks::format_timestamp(at<std::chrono::seconds>(0), buffer.data(),
+                                      buffer.data() + buffer.size());
+  REQUIRE(end.is_value());
+  CHECK(std::string(buffer.data(), end.unwrap_or(buffer.data())) == "1970-01-01T00:00:00Z");
+
+  end = bricks::format_timestamp(at<std::chrono::milliseconds>(0), buffer.data(),
+                                 buffer.data() + buffer.size());
+  REQUIRE(end.is_error());
+  CHECK(end.unwrap_error() == std::errc::value_too_large);
+
+  auto text = bricks::format_timestamp(at<std::chrono::seconds>(253402300800));
+  REQUIRE(text.is_error());
+  CHECK(text.unwrap_error() == std::errc::value_too_large);
+}
+
+TEST_CASE("Formatting and parsing round-trip")
+{
+  bricks::timestamp_formatter formatter;
+  bricks::timestamp_parser parser;
+  for (std::int64_t seconds = -200000; seconds < 400000; seconds += 7919) {
+    const auto time = at(seconds, 123456789ns);
+    const auto text = formatter.format(time).unwrap_or("");
+    CAPTURE(text);
+    CHECK(text == bricks::format_timestamp(time).unwrap_or(""));
+    CHECK(parser.parse(text).unwrap_or({}) == time);
+  }
+}
+
+TEST_CASE("Works with to_string and from_string")
+{
+  const bricks::sys_time<std::chrono::seconds> time{1700000000s};
+  CHECK(bricks::to_string(time).unwrap_or("") == "2023-11-14T22:13:20Z");
+  CHECK(bricks::from_string<bricks::sys_time<std::chrono::seconds>>("2023-11-14T22:13:20Z")
+            .unwrap_or({}) == time);
+}
+
+TEST_SUITE_END();
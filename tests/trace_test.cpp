@@ -0,0 +1,187 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bricks/mutex.hpp>
+#include <bricks/rw_lock.hpp>
+#include <bricks/timer.hpp>
+#include <bricks/trace.hpp>
+#include <chrono>
+#include <set>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+TEST_SUITE_BEGIN("[trace]");
+
+namespace {
+
+auto spans_named(std::string_view name) -> std::vector<bricks::trace_event>
+{
+  auto events = bricks::collect_trace();
+  events.erase(std::remove_if(events.begin(), events.end(),
+                              [name](const auto& e) { return std::string_view{e.name} != name; }),
+               events.end());
+  return events;
+}
+
+}  // namespace
+
+TEST_CASE("example")
+{
+  /// [trace-example]
+  {
+    BRICKS_TRACE_SCOPE("load config");  // Only recorded if BRICKS_ENABLE_TRACE is defined.
+  }
+
+  std::ostringstream out;
+  bricks::write_chrome_trace(out);  // Open the output in chrome://tracing or ui.perfetto.dev
+  /// [trace-example]
+  CHECK(out.str().rfind(R"({"displayTimeUnit":"ns","traceEvents":[)", 0) == 0);
+}
+
+TEST_CASE("trace_scope example")
+{
+  bricks::clear_trace();
+  /// [trace_scope-example]
+  {
+    const bricks::trace_scope span{"parse request"};
+    // ... work to be measured ...
+  }
+
+  const auto events = bricks::collect_trace();
+  /// [trace_scope-example]
+  REQUIRE(!events.empty());
+  CHECK(std::string{events.back().name} == "parse request");
+  CHECK(events.back().end_ns >= events.back().begin_ns);
+}
+
+TEST_CASE("spans of different threads get different thread ids")
+{
+  static const char* const name = "thread span";
+  std::thread{[] { const bricks::trace_scope span{name}; }}.join();
+  std::thread{[] { const bricks::trace_scope span{name}; }}.join();
+
+  const auto events = spans_named(name);
+  REQUIRE(events.size() == 2);
+  CHECK(events[0].thread_id != events[1].thread_id);
+}
+
+TEST_CASE("nested spans are contained in their parent")
+{
+  static const char* const outer = "outer span";
+  static const char* const inner = "inner span";
+  {
+    const bricks::trace_scope outer_span{outer};
+    const bricks::trace_scope inner_span{inner};
+  }
+
+  const auto outer_events = spans_named(outer);
+  const auto inner_events = spans_named(inner);
+  REQUIRE(outer_events.size() == 1);
+  REQUIRE(inner_events.size() == 1);
+  CHECK(outer_events[0].begin_ns <= inner_events[0].begin_ns);
+  CHECK(outer_events[0].end_ns >= inner_events[0].end_ns);
+}
+
+TEST_CASE("buffer keeps only the most recent spans")
+{
+  static const char* const name = "ring span";
+  std::thread{[] {
+    for (std::uint64_t i = 0; i < bricks::detail::trace_buffer::capacity + 10; ++i) {
+      const bricks::trace_scope span{name};
+    }
+  }}.join();
+
+  CHECK(spans_named(name).size() == bricks::detail::trace_buffer::capacity);
+}
+
+TEST_CASE("clear_trace discards recorded spans")
+{
+  static const char* const name = "cleared span";
+  { const bricks::trace_scope span{name}; }
+  REQUIRE(spans_named(name).size() == 1);
+
+  bricks::clear_trace();
+  CHECK(spans_named(name).empty());
+}
+
+TEST_CASE("chrome trace contains complete events")
+{
+  bricks::clear_trace();
+  { const bricks::trace_scope span{"quoted \"name\""}; }
+
+  std::ostringstream out;
+  bricks::write_chrome_trace(out);
+  const auto json = out.str();
+  CHECK(json.find(R"("name":"quoted \"name\"")") != std::string::npos);
+  CHECK(json.find(R"("ph":"X")") != std::string::npos);
+  CHECK(json.find(R"("dur":)") != std::string::npos);
+  CHECK(json.back() == '}');
+}
+
+TEST_CASE("chrome trace escapes control characters")
+{
+  bricks::clear_trace();
+  { const bricks::trace_scope span{"line\nbreak\ttab\x01" "bell\x1f"}; }
+
+  std::ostringstream out;
+  bricks::write_chrome_trace(out);
+  const auto json = out.str();
+  CHECK(json.find(R"("name":"line\nbreak\ttab\u0001bell\u001f")") != std::string::npos);
+  CHECK(std::none_of(json.begin(), json.end(),
+                     [](char c) { return static_cast<unsigned char>(c) < 0x20; }));
+}
+
+#ifdef BRICKS_ENABLE_TRACE
+TEST_CASE("timers record spans")
+{
+  bricks::clear_trace();
+  const bricks::timer timer;
+  timer.start(std::chrono::milliseconds{1}).get();
+
+  CHECK(spans_named("bricks::timer").size() == 1);
+}
+
+TEST_CASE("locks record spans only when they wait")
+{
+  bricks::clear_trace();
+  bricks::mutex<std::vector<int>> mutex;
+  mutex.lock()->push_back(1);
+  bricks::rw_lock<std::vector<int>> rw_lock;
+  rw_lock.write()->push_back(1);
+  CHECK(rw_lock.read()->size() == 1);
+  CHECK(spans_named("bricks::write_guard wait").empty());
+  CHECK(spans_named("bricks::read_guard wait").empty());
+
+  // Hold the locks until the other threads are about to acquire them, and a bit longer.
+  std::atomic<int> waiting{0};
+  std::thread writer;
+  std::thread reader;
+  {
+    const auto mutex_guard = mutex.lock();
+    const auto write_guard = rw_lock.write();
+    writer = std::thread{[&] {
+      ++waiting;
+      mutex.lock()->push_back(2);
+    }};
+    reader = std::thread{[&] {
+      ++waiting;
+      CHECK(rw_lock.read()->size() == 1);
+    }};
+    while (waiting.load() != 2) {
+      std::this_thread::yield();
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+  }
+  writer.join();
+  reader.join();
+
+  CHECK(spans_named("bricks::write_guard wait").size() == 1);
+  CHECK(spans_named("bricks::read_guard wait").size() == 1);
+}
+#endif
+
+TEST_SUITE_END();
@@ -1,6 +1,11 @@
 #include <doctest/doctest.h>
 
 #include <bricks/type_traits.hpp>
+#include <deque>
+#include <forward_list>
+#include <list>
+#include <string>
+#include <utility>
 #include <vector>
 
 /// [has_find-example]
@@ -24,3 +29,46 @@ static_assert(!bricks::is_iterator_v<int>);
 static_assert(bricks::is_iterator_v<std::vector<int>::iterator>);
 static_assert(bricks::is_iterator_v<std::vector<int>::const_iterator>);
 /// [is_iterator-example]
+
+/// [is_trivially_relocatable-example]
+struct owning_handle {
+  owning_handle() = default;
+  owning_handle(owning_handle&& other) noexcept : ptr(std::exchange(other.ptr, nullptr)) {}
+  ~owning_handle() { delete ptr; }
+  int* ptr{nullptr};
+};
+
+template <>
+struct bricks::is_trivially_relocatable<owning_handle> : std::true_type {
+};
+
+static_assert(bricks::is_trivially_relocatable_v<int>);
+static_assert(!bricks::is_trivially_relocatable_v<std::vector<int>>);
+static_assert(bricks::is_trivially_relocatable_v<owning_handle>);
+/// [is_trivially_relocatable-example]
+
+/// [range-traits-example]
+static_assert(std::is_same_v<bricks::range_value_t<std::list<int>>, int>);
+
+static_assert(bricks::is_sized_range_v<std::list<int>>);
+static_assert(!bricks::is_sized_range_v<std::forward_list<int>>);
+
+static_assert(bricks::is_random_access_iterator_v<int*>);
+static_assert(!bricks::is_random_access_iterator_v<std::list<int>::iterator>);
+static_assert(bricks::is_random_access_range_v<std::deque<int>>);
+static_assert(!bricks::is_random_access_range_v<std::list<int>>);
+
+static_assert(bricks::is_contiguous_range_v<std::vector<int>>);
+static_assert(bricks::is_contiguous_range_v<const std::string>);
+static_assert(bricks::is_contiguous_range_v<int[4]>);
+static_assert(!bricks::is_contiguous_range_v<std::deque<int>>);
+static_assert(!bricks::is_contiguous_range_v<std::vector<bool>>);
+/// [range-traits-example]
+
+enum class color { red, green };
+
+static_assert(bricks::is_bitwise_comparable_v<int>);
+static_assert(bricks::is_bitwise_comparable_v<color>);
+static_assert(bricks::is_bitwise_comparable_v<const char*>);
+static_assert(!bricks::is_bitwise_comparable_v<double>);
+static_assert(!bricks::is_bitwise_comparable_v<std::string>);
@@ -0,0 +1,266 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <bricks/utf8.hpp>
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Well-formed UTF-8 byte sequences, table 3-7 of the Unicode standard.
+auto reference_validate(const std::string& str) -> std::size_t
+{
+  const auto byte = [&str](std::size_t i) { return static_cast<unsigned char>(str[i]); };
+  const auto in_range = [&](std::size_t i, unsigned lo, unsigned hi) {
+    return i < str.size() && byte(i) >= lo && byte(i) <= hi;
+  };
+
+  std::size_t i = 0;
+  while (i < str.size()) {
+    const auto b = byte(i);
+    std::size_t length = 0;
+    if (b <= 0x7f) {
+      length = 1;
+    } else if (b >= 0xc2 && b <= 0xdf) {
+      length = in_range(i + 1, 0x80, 0xbf) ? 2 : 0;
+    } else if (b == 0xe0) {
+      length = in_range(i + 1, 0xa0, 0xbf) && in_range(i + 2, 0x80, 0xbf) ? 3 : 0;
+    } else if ((b >= 0xe1 && b <= 0xec) || b == 0xee || b == 0xef) {
+      length = in_range(i + 1, 0x80, 0xbf) && in_range(i + 2, 0x80, 0xbf) ? 3 : 0;
+    } else if (b == 0xed) {
+      length = in_range(i + 1, 0x80, 0x9f) && in_range(i + 2, 0x80, 0xbf) ? 3 : 0;
+    } else if (b == 0xf0) {
+      length = in_range(i + 1, 0x90, 0xbf) && in_range(i + 2, 0x80, 0xbf) &&
+                       in_range(i + 3, 0x80, 0xbf)
+                   ? 4
+                   : 0;
+    } else if (b >= 0xf1 && b <= 0xf3) {
+      length = in_range(i + 1, 0x80, 0xbf) && in_range(i + 2, 0x80, 0xbf) &&
+                       in_range(i + 3, 0x80, 0xbf)
+                   ? 4
+                   : 0;
+    } else if (b == 0xf4) {
+      length = in_range(i + 1, 0x80, 0x8f) && in_range(i + 2, 0x80, 0xbf) &&
+                       in_range(i + 3, 0x80, 0xbf)
+                   ? 4
+                   : 0;
+    }
+    if (length == 0) return i;
+    i += length;
+  }
+  return str.size();
+}
+
+auto random_text(std::size_t characters, std::mt19937& rng) -> std::string
+{
+  const std::array<const char*, 6> samples{"a", "Z", "\xc3\xa9", "\xe2\x82\xac", "\xf0\x9f\x98\x80",
+                                           "\xed\x9f\xbf"};
+  std::uniform_int_distribution<std::size_t> pick{0, samples.size() - 1};
+  std::uniform_int_distribution<int> ascii_run{0, 3};
+  std::string text;
+  for (std::size_t i = 0; i < characters; ++i) {
+    // Mostly ASCII, like real text, so both kernel paths are used.
+    text += ascii_run(rng) == 0 ? samples[pick(rng)] : "x";
+  }
+  return text;
+}
+
+}  // namespace
+
+TEST_SUITE_BEGIN("[utf8]");
+
+TEST_CASE("is_ascii example")
+{
+  /// [is_ascii-example]
+  CHECK(bricks::is_ascii("plain text"));
+  CHECK_FALSE(bricks::is_ascii("caf\xc3\xa9"));
+  /// [is_ascii-example]
+}
+
+TEST_CASE("validate_utf8 example")
+{
+  /// [validate_utf8-example]
+  auto valid = bricks::validate_utf8("caf\xc3\xa9");
+  REQUIRE(valid.is_value());
+  CHECK(valid.unwrap() == "caf\xc3\xa9");
+
+  auto invalid = bricks::validate_utf8("caf\xc3");
+  REQUIRE(invalid.is_error());
+  CHECK(invalid.unwrap_error() == bricks::utf_error{std::errc::illegal_byte_sequence, 3});
+  /// [validate_utf8-example]
+}
+
+TEST_CASE("utf8_to_utf16 example")
+{
+  /// [utf8_to_utf16-example]
+  auto utf16 = bricks::utf8_to_utf16("\xe2\x82\xac\xf0\x9f\x98\x80");
+  REQUIRE(utf16.is_value());
+  CHECK(utf16.unwrap() == u"€\U0001F600");
+
+  auto utf8 = bricks::utf16_to_utf8(u"€\U0001F600");
+  REQUIRE(utf8.is_value());
+  CHECK(utf8.unwrap() == "\xe2\x82\xac\xf0\x9f\x98\x80");
+  /// [utf8_to_utf16-example]
+}
+
+TEST_CASE("is_ascii finds a single non-ASCII byte anywhere")
+{
+  for (std::size_t size = 1; size < 300; size += 13) {
+    std::string text(size, 'a');
+    CHECK(bricks::is_ascii(text));
+    for (std::size_t pos = 0; pos < size; pos += 7) {
+      text[pos] = '\x80';
+      CHECK_FALSE(bricks::is_ascii(text));
+      text[pos] = 'a';
+    }
+  }
+}
+
+TEST_CASE("Rejects the invalid sequences")
+{
+  const std::vector<std::string> invalid{
+      "\x80",                  // lone continuation
+      "\xc0\xaf",              // overlong two byte
+      "\xc1\xbf",              // overlong two byte
+      "\xe0\x9f\xbf",          // overlong three byte
+      "\xf0\x8f\xbf\xbf",      // overlong four byte
+      "\xed\xa0\x80",          // surrogate
+      "\xf4\x90\x80\x80",      // above U+10FFFF
+      "\xf5\x80\x80\x80",      // invalid lead
+      "\xff",                  // invalid lead
+      "\xe2\x82",              // truncated
+      "\xe2\x82x",             // missing continuation
+      "\xc3\xa9\xa9",          // extra continuation
+  };
+  for (const auto& sequence : invalid) {
+    for (const std::size_t prefix : {0, 5, 13, 15, 16, 31, 32, 63, 100}) {
+      const auto text = std::string(prefix, 'a') + sequence + std::string(40, 'b');
+      CAPTURE(prefix);
+      auto checked = bricks::validate_utf8(text);
+      REQUIRE(checked.is_error());
+      CHECK(checked.unwrap_error().offset == reference_validate(text));
+      CHECK(checked.unwrap_error().code == std::errc::illegal_byte_sequence);
+    }
+  }
+}
+
+TEST_CASE("Matches the reference validator on mutated text")
+{
+  std::mt19937 rng{7};
+  std::uniform_int_distribution<int> byte{0, 255};
+  for (int round = 0; round < 2000; ++round) {
+    auto text = random_text(1 + round % 90, rng);
+    if (round % 3 != 0) {
+      std::uniform_int_distribution<std::size_t> pos{0, text.size() - 1};
+      text[pos(rng)] = static_cast<char>(byte(rng));
+    }
+
+    const auto expected = reference_validate(text);
+    const auto checked = bricks::validate_utf8(text);
+    CAPTURE(round);
+    if (expected == text.size()) {
+      CHECK(checked.is_value());
+    } else {
+      REQUIRE(checked.is_error());
+      CHECK(checked.unwrap_error().offset == expected);
+    }
+  }
+}
+
+TEST_CASE("Transcoding round-trips")
+{
+  std::mt19937 rng{11};
+  for (std::size_t characters = 0; characters < 200; characters += 9) {
+    const auto text = random_text(characters, rng);
+    auto utf16 = bricks::utf8_to_utf16(text);
+    REQUIRE(utf16.is_value());
+    auto utf8 = bricks::utf16_to_utf8(utf16.unwrap());
+    REQUIRE(utf8.is_value());
+    CHECK(utf8.unwrap() == text);
+  }
+}
+
+TEST_CASE("ASCII kernels stop at the block with the first non-ASCII character")
+{
+  const auto check_kernels = [](std::size_t size, std::size_t non_ascii) {
+    CAPTURE(size);
+    CAPTURE(non_ascii);
+    std::string utf8(size, 'a');
+    std::u16string utf16(size, u'a');
+    if (non_ascii < size) {
+      utf8[non_ascii] = '\xc3';
+      utf16[non_ascii] = u'\xe9';
+    }
+    const auto* in = reinterpret_cast<const unsigned char*>(utf8.data());  // NOLINT
+    const auto ascii = std::min(size, non_ascii);
+
+    const auto check_widen = [&](auto kernel) {
+      std::u16string out(size, u'\0');
+      const auto widened = kernel(in, size, out.data());
+      CHECK(widened == ascii / 16 * 16);
+      CHECK(widened + 16 > ascii);
+      CHECK(out.compare(0, widened, utf16, 0, widened) == 0);
+    };
+    const auto check_narrow = [&](auto kernel) {
+      std::string out(size, '\0');
+      const auto narrowed = kernel(utf16.data(), size, out.data());
+      CHECK(narrowed == ascii / 16 * 16);
+      CHECK(narrowed + 16 > ascii);
+      CHECK(out.compare(0, narrowed, utf8, 0, narrowed) == 0);
+    };
+
+    const auto& features = bricks::cpu_features::current();
+    if (features.sse2) {
+      check_widen(bricks::detail::widen_ascii_sse2);
+      check_narrow(bricks::detail::narrow_ascii_sse2);
+    }
+    if (features.avx2) {
+      check_widen(bricks::detail::widen_ascii_avx2);
+      check_narrow(bricks::detail::narrow_ascii_avx2);
+    }
+  };
+
+  for (std::size_t size = 0; size < 100; size += 13) {
+    for (std::size_t non_ascii = 0; non_ascii <= size; non_ascii += 5) {
+      check_kernels(size, non_ascii);
+    }
+  }
+}
+
+TEST_CASE("Transcoding reports invalid input")
+{
+  auto utf16 = bricks::utf8_to_utf16(std::string(20, 'a') + "\xed\xa0\x80");
+  REQUIRE(utf16.is_error());
+  CHECK(utf16.unwrap_error() == bricks::utf_error{std::errc::illegal_byte_sequence, 20});
+
+  const std::u16string lone_high = std::u16string(18, u'a') + u'\xd800' + u'a';
+  auto utf8 = bricks::utf16_to_utf8(lone_high);
+  REQUIRE(utf8.is_error());
+  CHECK(utf8.unwrap_error() == bricks::utf_error{std::errc::illegal_byte_sequence, 18});
+
+  const std::u16string lone_low = u"a\xdc00";
+  CHECK(bricks::utf16_to_utf8(lone_low).unwrap_error().offset == 1);
+}
+
+TEST_CASE("Transcoding into buffers checks their size")
+{
+  std::array<char16_t, 4> utf16{};
+  auto end = bricks::utf8_to_utf16("ab\xf0\x9f\x98\x80", utf16.data(), utf16.data() + utf16.size());
+  REQUIRE(end.is_value());
+  CHECK(end.unwrap() == utf16.data() + 4);
+
+  end = bricks::utf8_to_utf16("abc\xf0\x9f\x98\x80", utf16.data(), utf16.data() + utf16.size());
+  REQUIRE(end.is_error());
+  CHECK(end.unwrap_error() == bricks::utf_error{std::errc::value_too_large, 3});
+
+  std::array<char, 20> utf8{};
+  const std::u16string ascii(32, u'a');
+  auto utf8_end = bricks::utf16_to_utf8(ascii, utf8.data(), utf8.data() + utf8.size());
+  REQUIRE(utf8_end.is_error());
+  CHECK(utf8_end.unwrap_error() == bricks::utf_error{std::errc::value_too_large, 20});
+}
+
+TEST_SUITE_END();
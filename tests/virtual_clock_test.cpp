@@ -0,0 +1,176 @@
+#include <doctest/doctest.h>
+
+#include <bricks/virtual_clock.hpp>
+#include <chrono>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+#include "string_makers.hpp"
+
+TEST_SUITE_BEGIN("[virtual_clock]");
+
+using namespace std::chrono_literals;  // NOLINT
+
+namespace {
+
+auto is_ready(const std::future<void>& token) -> bool
+{
+  return token.wait_for(0s) == std::future_status::ready;
+}
+
+// The timer has the interface of the real one, and both are constructed from their clock. Only
+// the real one can also be default constructed, since it does not need the clock object.
+using virtual_timer = bricks::basic_timer<bricks::virtual_clock>;
+template <typename Timer>
+constexpr bool nothrow_start_v =
+    noexcept(std::declval<const Timer&>().start(std::declval<std::chrono::seconds>()));
+static_assert(nothrow_start_v<bricks::timer>);
+static_assert(nothrow_start_v<virtual_timer>);
+static_assert(std::is_constructible_v<bricks::timer, std::chrono::steady_clock&>);
+static_assert(std::is_constructible_v<virtual_timer, bricks::virtual_clock&>);
+static_assert(!std::is_default_constructible_v<virtual_timer>);
+
+template <typename Clock>
+auto start_and_abort(Clock& clock) -> std::future<void>
+{
+  bricks::basic_timer<Clock> timer{clock};
+  auto token = timer.start(1h);
+  timer.abort();
+  return token;
+}
+
+}  // namespace
+
+TEST_CASE("example")
+{
+  /// [virtual_clock-example]
+  bricks::virtual_clock clock;
+  bricks::basic_timer<bricks::virtual_clock> timer{clock};
+
+  auto timeout = timer.start(30s);
+  CHECK(timeout.wait_for(0s) == std::future_status::timeout);
+
+  clock.advance(29s);  // Returns immediately, nothing sleeps
+  CHECK(timeout.wait_for(0s) == std::future_status::timeout);
+
+  clock.advance(1s);  // Fires the timer before returning
+  CHECK(timeout.wait_for(0s) == std::future_status::ready);
+  /// [virtual_clock-example]
+}
+
+TEST_CASE("clock starts at its epoch and only moves when advanced")
+{
+  bricks::virtual_clock clock;
+  CHECK(clock.now().time_since_epoch() == 0s);
+
+  clock.advance(1500ms);
+  CHECK(clock.now().time_since_epoch() == 1500ms);
+
+  clock.advance(-1s);
+  CHECK(clock.now().time_since_epoch() == 1500ms);
+}
+
+TEST_CASE("timers fire in deadline order")
+{
+  bricks::virtual_clock clock;
+  bricks::basic_timer<bricks::virtual_clock> timer{clock};
+
+  auto late = timer.start(3ms);
+  auto early = timer.start(1ms);
+  auto middle = timer.start(2ms);
+  CHECK(clock.pending() == 3);
+
+  clock.advance(1ms);
+  CHECK(is_ready(early));
+  CHECK_FALSE(is_ready(middle));
+  CHECK_FALSE(is_ready(late));
+
+  clock.advance(1ms);
+  CHECK(is_ready(middle));
+  CHECK_FALSE(is_ready(late));
+
+  clock.advance(10ms);
+  CHECK(is_ready(late));
+  CHECK(clock.pending() == 0);
+}
+
+TEST_CASE("durations that are not positive complete immediately")
+{
+  bricks::virtual_clock clock;
+  bricks::basic_timer<bricks::virtual_clock> timer{clock};
+
+  CHECK(is_ready(timer.start()));
+  CHECK(is_ready(timer.start(-1ms)));
+  CHECK(clock.pending() == 0);
+}
+
+TEST_CASE("aborting completes only the timer's own tokens")
+{
+  bricks::virtual_clock clock;
+  bricks::basic_timer<bricks::virtual_clock> aborted{clock};
+  bricks::basic_timer<bricks::virtual_clock> running{clock};
+
+  auto aborted_token = aborted.start(1h);
+  auto running_token = running.start(1h);
+  aborted.abort();
+
+  CHECK(is_ready(aborted_token));
+  CHECK_NOTHROW(aborted_token.get());
+  CHECK_FALSE(is_ready(running_token));
+  CHECK(clock.pending() == 1);
+}
+
+TEST_CASE("destroying a timer aborts it")
+{
+  bricks::virtual_clock clock;
+  std::future<void> token;
+  {
+    bricks::basic_timer<bricks::virtual_clock> timer{clock};
+    token = timer.start(1h);
+  }
+  CHECK(is_ready(token));
+}
+
+TEST_CASE("moved timers keep their tokens")
+{
+  bricks::virtual_clock clock;
+  bricks::basic_timer<bricks::virtual_clock> timer{clock};
+  auto token = timer.start(1s);
+
+  auto moved = std::move(timer);
+  timer.abort();  // NOLINT(bugprone-use-after-move)
+  CHECK_FALSE(is_ready(token));
+
+  moved.abort();
+  CHECK(is_ready(token));
+}
+
+TEST_CASE("can be restarted after firing")
+{
+  bricks::virtual_clock clock;
+  bricks::basic_timer<bricks::virtual_clock> timer{clock};
+
+  auto token = timer.start(1s);
+  clock.advance(1s);
+  CHECK(is_ready(token));
+
+  token = timer.start(1s);
+  CHECK_FALSE(is_ready(token));
+  clock.advance(1s);
+  CHECK(is_ready(token));
+}
+
+TEST_CASE("code generic over the clock constructs timers the same way")
+{
+  std::chrono::steady_clock steady;
+  bricks::virtual_clock virtual_time;
+
+  auto steady_token = start_and_abort(steady);
+  auto virtual_token = start_and_abort(virtual_time);
+
+  CHECK(steady_token.wait_for(1s) == std::future_status::ready);
+  CHECK(is_ready(virtual_token));
+}
+
+TEST_SUITE_END();